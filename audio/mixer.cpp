@@ -175,7 +175,7 @@ private:
 
 // TODO: parameter "system" is unused
 MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(), _reportedUnderruns(0) {
 
 	assert(sampleRate > 0);
 
@@ -186,6 +186,14 @@ MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	// The backend has stopped calling mixCallback() by now
+	if (_callbackStats.callbacks) {
+		debug(1, "MixerImpl: %d callbacks, average %.2f ms, max %d ms, %d underruns; waited %d ms for the mixer lock in total, max %d ms",
+			_callbackStats.callbacks, (double)_callbackStats.totalTime / _callbackStats.callbacks,
+			_callbackStats.maxTime, _callbackStats.underruns,
+			_callbackStats.totalLockWait, _callbackStats.maxLockWait);
+	}
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -196,7 +204,18 @@ uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
-void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
+void MixerImpl::retireChannel(int index, Channel **retired, int &numRetired) {
+	assert(_channels[index]);
+	retired[numRetired++] = _channels[index];
+	_channels[index] = 0;
+}
+
+void MixerImpl::deleteChannels(Channel **channels, int numChannels) {
+	for (int i = 0; i < numChannels; i++)
+		delete channels[i];
+}
+
+bool MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] == 0) {
@@ -206,8 +225,7 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	}
 	if (index == -1) {
 		warning("MixerImpl::out of mixer slots");
-		delete chan;
-		return;
+		return false;
 	}
 
 	_channels[index] = chan;
@@ -219,6 +237,7 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+	return true;
 }
 
 void MixerImpl::playStream(
@@ -229,8 +248,6 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == 0) {
 		warning("stream is 0");
 		return;
@@ -239,97 +256,154 @@ void MixerImpl::playStream(
 
 	assert(_mixerReady);
 
-	// Prevent duplicate sounds
-	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
-				// Delete the stream if were asked to auto-dispose it.
-				// Note: This could cause trouble if the client code does not
-				// yet expect the stream to be gone. The primary example to
-				// keep in mind here is QueuingAudioStream.
-				// Thus, as a quick rule of thumb, you should never, ever,
-				// try to play QueuingAudioStreams with a sound id.
-				if (autofreeStream == DisposeAfterUse::YES)
-					delete stream;
-				return;
-			}
-	}
-
 #ifdef AUDIO_REVERSE_STEREO
 	reverseStereo = !reverseStereo;
 #endif
 
-	// Create the channel
+	// Create the channel. This is done before locking the mixer, so that
+	// the mixer callback never has to wait for a rate converter to be set up.
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
-	insertChannel(handle, chan);
+
+	bool inserted;
+	uint32 newUnderruns = 0, maxTime = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		// Prevent duplicate sounds
+		bool duplicate = false;
+		if (id != -1) {
+			for (int i = 0; i != NUM_CHANNELS; i++)
+				if (_channels[i] != 0 && _channels[i]->getId() == id) {
+					duplicate = true;
+					break;
+				}
+		}
+
+		inserted = !duplicate && insertChannel(handle, chan);
+
+		newUnderruns = _callbackStats.underruns - _reportedUnderruns;
+		_reportedUnderruns = _callbackStats.underruns;
+		maxTime = _callbackStats.maxTime;
+	}
+
+	if (newUnderruns)
+		debug(2, "MixerImpl: %d mixer callbacks took longer than the audio they produced, the slowest %d ms", newUnderruns, maxTime);
+
+	if (inserted)
+		return;
+
+	// Deleting the channel also deletes the stream if we were asked to
+	// auto-dispose it.
+	// Note: This could cause trouble if the client code does not
+	// yet expect the stream to be gone. The primary example to
+	// keep in mind here is QueuingAudioStream.
+	// Thus, as a quick rule of thumb, you should never, ever,
+	// try to play QueuingAudioStreams with a sound id.
+	delete chan;
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
+	const uint32 startTime = g_system->getMillis(true);
 
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
 	assert(len % 4 == 0);
 	len >>= 2;
 
-	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	int res = 0, tmp;
 
-	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	{
+		Common::StackLock lock(_mutex);
 
-	// mix all channels
-	int res = 0, tmp;
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i]) {
-			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
+		const uint32 lockWait = g_system->getMillis(true) - startTime;
+		_callbackStats.totalLockWait += lockWait;
+		_callbackStats.maxLockWait = MAX(_callbackStats.maxLockWait, lockWait);
+
+		// Since the mixer callback has been called, the mixer must be ready...
+		_mixerReady = true;
+
+		//  zero the buf
+		memset(buf, 0, 2 * len * sizeof(int16));
+
+		// mix all channels
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channels[i]) {
+				if (_channels[i]->isFinished()) {
+					// Finished channels are deleted while still holding
+					// the lock. Engines rely on the stream being gone
+					// once isSoundHandleActive() returns false.
+					delete _channels[i];
+					_channels[i] = 0;
+				} else if (!_channels[i]->isPaused()) {
+					tmp = _channels[i]->mix(buf, len);
+
+					if (tmp > res)
+						res = tmp;
+				}
 			}
-		}
+
+		const uint32 elapsed = g_system->getMillis(true) - startTime;
+		_callbackStats.callbacks++;
+		_callbackStats.totalTime += elapsed;
+		_callbackStats.maxTime = MAX(_callbackStats.maxTime, elapsed);
+		if (elapsed > len * 1000 / _sampleRate)
+			_callbackStats.underruns++;
+	}
 
 	return res;
 }
 
 void MixerImpl::stopAll() {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
+	Channel *retired[NUM_CHANNELS];
+	int numRetired = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && !_channels[i]->isPermanent())
+				retireChannel(i, retired, numRetired);
 		}
 	}
+
+	deleteChannels(retired, numRetired);
 }
 
 void MixerImpl::stopID(int id) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
+	Channel *retired[NUM_CHANNELS];
+	int numRetired = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != 0 && _channels[i]->getId() == id)
+				retireChannel(i, retired, numRetired);
 		}
 	}
+
+	deleteChannels(retired, numRetired);
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Channel *retired[1];
+	int numRetired = 0;
 
-	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	{
+		Common::StackLock lock(_mutex);
 
-	delete _channels[index];
-	_channels[index] = 0;
+		// Simply ignore stop requests for handles of sounds that already terminated
+		const int index = handle._val % NUM_CHANNELS;
+		if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+			return;
+
+		retireChannel(index, retired, numRetired);
+	}
+
+	deleteChannels(retired, numRetired);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
@@ -70,6 +70,37 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * Timing statistics of mixCallback(), to diagnose audio dropouts.
+	 * All times are in milliseconds. They are only accessed under _mutex.
+	 */
+	struct CallbackStats {
+		CallbackStats() : callbacks(0), underruns(0), totalTime(0), maxTime(0), totalLockWait(0), maxLockWait(0) {}
+
+		uint32 callbacks;     ///< number of callbacks so far
+		uint32 underruns;     ///< callbacks which took longer than the audio they produced
+		uint32 totalTime;     ///< time spent in all callbacks
+		uint32 maxTime;       ///< time spent in the slowest callback
+		uint32 totalLockWait; ///< time the callbacks waited for other threads to release the mixer
+		uint32 maxLockWait;   ///< longest such wait
+	};
+
+	CallbackStats _callbackStats;
+
+	/**
+	 * Number of underruns already reported. The callback must not log
+	 * anything itself, so playStream() reports new ones instead.
+	 */
+	uint32 _reportedUnderruns;
+
+	/**
+	 * Remove the channel in the given slot from the channel table. The
+	 * channel is appended to the given list instead of being deleted, so
+	 * that callers can delete it after releasing _mutex.
+	 */
+	void retireChannel(int index, Channel **retired, int &numRetired);
+	static void deleteChannels(Channel **channels, int numChannels);
+
 
 public:
 
@@ -119,7 +150,7 @@ public:
 	virtual uint getOutputRate() const;
 
 protected:
-	void insertChannel(SoundHandle *handle, Channel *chan);
+	bool insertChannel(SoundHandle *handle, Channel *chan);
 
 public:
 	/**
@@ -35,6 +35,11 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#if defined(__SSE2__) && !defined(OUTPUT_UNSIGNED_AUDIO)
+#define USE_SSE2_MIXING
+#include <emmintrin.h>
+#endif
+
 namespace Audio {
 
 
@@ -57,6 +62,82 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Apply the volume to a buffer of (resampled) input frames, and add the
+ * result to the output buffer with clamping.
+ *
+ * This is the innermost loop of the mixer, run for every active channel,
+ * so it is vectorized where possible. All implementations give exactly
+ * the same result as the plain C code at the end of this function.
+ *
+ * @param obuf       output buffer, holding numFrames stereo sample pairs
+ * @param in         input buffer, holding numFrames mono samples or
+ *                   stereo sample pairs
+ * @param numFrames  number of frames to mix
+ */
+template<bool stereo, bool reverseStereo>
+static void mixBuffer(st_sample_t *obuf, const st_sample_t *in, st_size_t numFrames, st_volume_t vol_l, st_volume_t vol_r) {
+#ifdef USE_SSE2_MIXING
+	// Volumes in the order of the output channels. The right channel comes
+	// first when reversing stereo.
+	const int16 vol0 = reverseStereo ? vol_r : vol_l;
+	const int16 vol1 = reverseStereo ? vol_l : vol_r;
+	const __m128i vol = _mm_set_epi16(vol1, vol0, vol1, vol0, vol1, vol0, vol1, vol0);
+	const __m128i roundBias = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i samples;
+		if (stereo) {
+			samples = _mm_loadu_si128((const __m128i *)in);
+			if (reverseStereo) {
+				samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+				samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+			in += 8;
+		} else {
+			samples = _mm_loadl_epi64((const __m128i *)in);
+			samples = _mm_unpacklo_epi16(samples, samples);
+			in += 4;
+		}
+
+		// Full 32 bit products of samples and volumes
+		const __m128i productLow = _mm_mullo_epi16(samples, vol);
+		const __m128i productHigh = _mm_mulhi_epi16(samples, vol);
+		__m128i product0 = _mm_unpacklo_epi16(productLow, productHigh);
+		__m128i product1 = _mm_unpackhi_epi16(productLow, productHigh);
+
+		// Divide by kMaxMixerVolume (256). Like the C division, this rounds
+		// towards zero, so negative products need to be biased first.
+		product0 = _mm_add_epi32(product0, _mm_and_si128(_mm_srai_epi32(product0, 31), roundBias));
+		product1 = _mm_add_epi32(product1, _mm_and_si128(_mm_srai_epi32(product1, 31), roundBias));
+		product0 = _mm_srai_epi32(product0, 8);
+		product1 = _mm_srai_epi32(product1, 8);
+
+		// Add to the sign extended output, and clamp by packing with
+		// signed saturation.
+		const __m128i out = _mm_loadu_si128((const __m128i *)obuf);
+		const __m128i out0 = _mm_srai_epi32(_mm_unpacklo_epi16(out, out), 16);
+		const __m128i out1 = _mm_srai_epi32(_mm_unpackhi_epi16(out, out), 16);
+		_mm_storeu_si128((__m128i *)obuf, _mm_packs_epi32(_mm_add_epi32(out0, product0), _mm_add_epi32(out1, product1)));
+		obuf += 8;
+	}
+#endif
+
+	for (; numFrames > 0; --numFrames) {
+		st_sample_t out0, out1;
+		out0 = *in++;
+		out1 = (stereo ? *in++ : out0);
+
+		// output left channel
+		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+	}
+}
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -172,6 +253,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** interpolated samples, waiting to be mixed into the output */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -227,48 +311,55 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		// Interpolate a chunk of output samples into outBuf, and mix them
+		// into the output buffer in one go afterwards.
+		const st_size_t chunkFrames = MIN<st_size_t>((oend - obuf) / 2, ARRAYSIZE(outBuf) / (stereo ? 2 : 1));
+		st_sample_t *out = outBuf;
+		st_sample_t *const outEnd = outBuf + chunkFrames * (stereo ? 2 : 1);
+
+		while (out < outEnd) {
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
-			}
-			opos -= FRAC_ONE_LOW;
-		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
+			if (endOfInput)
+				break;
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && out < outEnd) {
+				// interpolate
+				*out++ = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (stereo)
+					*out++ = (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-
-			// Increment output position
-			opos += opos_inc;
+				// Increment output position
+				opos += opos_inc;
+			}
 		}
+
+		const st_size_t frames = (out - outBuf) / (stereo ? 2 : 1);
+		mixBuffer<stereo, reverseStereo>(obuf, outBuf, frames, vol_l, vol_r);
+		obuf += frames * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -293,7 +384,6 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
 		st_sample_t *ostart = obuf;
@@ -315,20 +405,9 @@ public:
 		len = input.readBuffer(_buffer, osamp);
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-		}
+		const st_size_t frames = len / (stereo ? 2 : 1);
+		mixBuffer<stereo, reverseStereo>(obuf, _buffer, frames, vol_l, vol_r);
+		obuf += frames * 2;
 		return (obuf - ostart) / 2;
 	}
 
@@ -183,6 +183,17 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance for reading game data from the
+	 * file referred by this node. In contrast to createReadStream(), the
+	 * stream may require the file to stay unmodified while it is open, e.g.
+	 * because it reads from a memory mapping. It must not be used for files
+	 * which are written to, like savegames.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createDataReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
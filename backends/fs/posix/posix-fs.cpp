@@ -32,6 +32,9 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/stdiostream.h"
+#ifdef HAVE_MMAP
+#include "backends/fs/posix/posix-mmapstream.h"
+#endif
 #include "common/algorithm.h"
 
 #include <sys/param.h>
@@ -254,6 +257,17 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createDataReadStream() {
+#ifdef HAVE_MMAP
+	// Big data files are mapped into memory instead of being read
+	// through stdio.
+	Common::SeekableReadStream *mapped = POSIXMmapStream::makeFromPath(getPath());
+	if (mapped)
+		return mapped;
+#endif
+	return createReadStream();
+}
+
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
 	return StdioStream::makeFromPath(getPath(), true);
 }
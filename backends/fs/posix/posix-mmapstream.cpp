@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use open, mmap etc.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/posix/posix-mmapstream.h"
+
+#ifdef HAVE_MMAP
+
+#include "common/util.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+POSIXMmapStream::POSIXMmapStream(void *mapping, uint32 size) :
+	Common::MemoryReadStream((const byte *)mapping, size, DisposeAfterUse::NO),
+	_mapping(mapping),
+	_mappingSize(size) {
+	assert(mapping);
+}
+
+POSIXMmapStream::~POSIXMmapStream() {
+	munmap(_mapping, _mappingSize);
+}
+
+bool POSIXMmapStream::seek(int32 offs, int whence) {
+	// MemoryReadStream asserts on seeks outside the stream. Behave like
+	// fseek() instead, which callers expect from a file: fail on negative
+	// positions, and let reads after seeking past the end hit end-of-stream.
+	int32 newPos = offs;
+	if (whence == SEEK_CUR)
+		newPos += pos();
+	else if (whence == SEEK_END)
+		newPos += size();
+
+	if (newPos < 0)
+		return false;
+
+	return Common::MemoryReadStream::seek(MIN(newPos, size()), SEEK_SET);
+}
+
+POSIXMmapStream *POSIXMmapStream::makeFromPath(const Common::String &path) {
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+	        st.st_size < kMinMappedFileSize || st.st_size > 0x7FFFFFFF) {
+		close(fd);
+		return 0;
+	}
+
+	const uint32 size = (uint32)st.st_size;
+	void *mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after closing the file descriptor
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return 0;
+
+	return new POSIXMmapStream(mapping, size);
+}
+
+#endif
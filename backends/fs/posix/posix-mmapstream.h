@@ -0,0 +1,71 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_POSIX_MMAPSTREAM_H
+#define BACKENDS_FS_POSIX_MMAPSTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+/**
+ * Read-only stream for a file which is mapped into memory with mmap().
+ *
+ * Reading from it does not involve any system calls or copying beyond
+ * what the caller asks for, and getData() gives direct access to the
+ * mapped bytes. Pages are only loaded when they are accessed and can be
+ * dropped by the kernel under memory pressure, so even big data files do
+ * not permanently add to the resident memory.
+ */
+class POSIXMmapStream : public Common::MemoryReadStream, public Common::NonCopyable {
+public:
+	enum {
+		/**
+		 * Files smaller than this are not worth mapping; reading them
+		 * through stdio is just as fast.
+		 */
+		kMinMappedFileSize = 256 * 1024
+	};
+
+	/**
+	 * Given a path, maps the file at that path into memory and wraps the
+	 * result in a POSIXMmapStream instance.
+	 *
+	 * @return the new stream, or 0 if the file could not be mapped (or is
+	 *         smaller than kMinMappedFileSize). Callers should fall back to
+	 *         regular file I/O in that case.
+	 */
+	static POSIXMmapStream *makeFromPath(const Common::String &path);
+
+	virtual ~POSIXMmapStream();
+
+	virtual bool seek(int32 offs, int whence = SEEK_SET);
+
+private:
+	POSIXMmapStream(void *mapping, uint32 size);
+
+	void *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
@@ -1160,6 +1160,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	updateOSD();
 #endif
 
+	buildDirtyRectList();
+
 	// Force a full redraw if requested
 	if (_forceFull) {
 		_numDirtyRects = 1;
@@ -1534,11 +1536,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 	if (_forceFull)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceFull = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!_overlayVisible && !realCoordinates) {
@@ -1577,25 +1574,85 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool re
 		h = height - y;
 	}
 
-#ifdef USE_SCALERS
-	if (_videoMode.aspectRatioCorrection && !_overlayVisible && !realCoordinates) {
-		makeRectStretchable(x, y, w, h);
-	}
-#endif
-
 	if (w == width && h == height) {
 		_forceFull = true;
 		return;
 	}
 
 	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+		// Rects in real coordinates are added by drawMouse(), after the
+		// screen has been scaled, so they only need to be passed on to
+		// SDL_UpdateRects().
+		if (realCoordinates) {
+			if (_numDirtyRects == NUM_DIRTY_RECT) {
+				_forceFull = true;
+				return;
+			}
+
+			SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+
+			r->x = x;
+			r->y = y;
+			r->w = w;
+			r->h = h;
+			return;
+		}
+
+		// The region covers both the game screen and the overlay, so it
+		// only needs to grow when the video mode changes. Rects added
+		// before are lost then, so redraw everything once.
+		if (_dirtyRegion.getWidth() < width || _dirtyRegion.getHeight() < height) {
+			_dirtyRegion.setSize(MAX<int>(_dirtyRegion.getWidth(), width), MAX<int>(_dirtyRegion.getHeight(), height));
+			_forceFull = true;
+			return;
+		}
+
+		_dirtyRegion.addRect(Common::Rect(x, y, x + w, y + h));
+	}
+}
+
+void SurfaceSdlGraphicsManager::buildDirtyRectList() {
+	_numDirtyRects = 0;
+
+	if (!_forceFull && !_dirtyRegion.isEmpty()) {
+		_dirtyRegion.getRects(_dirtyRegionRects);
 
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
+		// Leave room for the mouse cursor, which is added while drawing.
+		if (_dirtyRegionRects.size() >= NUM_DIRTY_RECT) {
+			_forceFull = true;
+		} else {
+			for (uint i = 0; i < _dirtyRegionRects.size(); ++i) {
+				const Common::Rect &rect = _dirtyRegionRects[i];
+				int x = rect.left, y = rect.top, w = rect.width(), h = rect.height();
+
+#ifdef USE_SCALERS
+				// The region splits rects at tile boundaries, so the rects
+				// it returns have to be made stretchable, not the ones added.
+				// The lines interpolated right above and below the stretched
+				// rect depend on its first and last line, so include their
+				// neighbours as well.
+				if (_videoMode.aspectRatioCorrection && !_overlayVisible) {
+					if (y > 0) {
+						y--;
+						h++;
+					}
+					if (y + h < _videoMode.screenHeight)
+						h++;
+					makeRectStretchable(x, y, w, h);
+				}
+#endif
+
+				SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+
+				r->x = x;
+				r->y = y;
+				r->w = w;
+				r->h = h;
+			}
+		}
 	}
+
+	_dirtyRegion.clear();
 }
 
 int16 SurfaceSdlGraphicsManager::getHeight() {
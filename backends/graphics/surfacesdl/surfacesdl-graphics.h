@@ -25,8 +25,10 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "graphics/dirty_region.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
+#include "common/array.h"
 #include "common/events.h"
 #include "common/system.h"
 
@@ -311,7 +313,11 @@ protected:
 		MAX_SCALING = 3
 	};
 
-	// Dirty rect management
+	// Dirty rect management. addDirtyRect() collects the changed areas in
+	// _dirtyRegion, buildDirtyRectList() turns them into _dirtyRectList
+	// for drawing.
+	Graphics::DirtyRegion _dirtyRegion;
+	Common::Array<Common::Rect> _dirtyRegionRects;
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
@@ -383,6 +389,13 @@ protected:
 
 	virtual void addDirtyRect(int x, int y, int w, int h, bool realCoordinates = false);
 
+	/**
+	 * Fill _dirtyRectList with the areas marked as dirty since the last
+	 * call, and reset them. Sets _forceFull if there are too many rects.
+	 * Has to be called by internUpdateScreen() before drawing.
+	 */
+	void buildDirtyRectList();
+
 	virtual void drawMouse();
 	virtual void undrawMouse();
 	virtual void blitCursor();
@@ -177,6 +177,11 @@ MODULE_OBJS += \
 	taskbar/unity/unity-taskbar.o
 endif
 
+ifdef HAVE_MMAP
+MODULE_OBJS += \
+	fs/posix/posix-mmapstream.o
+endif
+
 ifdef MACOSX
 MODULE_OBJS += \
 	audiocd/macosx/macosx-audiocd.o \
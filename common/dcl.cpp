@@ -22,6 +22,7 @@
 
 #include "common/dcl.h"
 #include "common/debug.h"
+#include "common/endian.h"
 #include "common/memstream.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -456,9 +457,193 @@ bool DecompressorDCL::unpack(SeekableReadStream *sourceStream, WriteStream *targ
 	return true; // For targets featuring dynamic size we always succeed
 }
 
+// Maximum code lengths of the Huffman trees above
+#define LENGTH_TREE_BITS 7
+#define DISTANCE_TREE_BITS 8
+#define ASCII_TREE_BITS 13
+
+/**
+ * DCL decompressor for data which is completely in memory and has a known
+ * unpacked size. It produces the same output as DecompressorDCL, but reads
+ * the bits from a 64-bit buffer which is refilled several bytes at a time,
+ * decodes the Huffman codes with lookup tables instead of walking the trees
+ * bit by bit, and copies matches directly inside the target buffer instead
+ * of going through the dictionary.
+ */
+class MemoryDecompressorDCL {
+public:
+	MemoryDecompressorDCL(const byte *source, uint32 sourceSize) :
+		_source(source), _sourceEnd(source + sourceSize), _bits(0), _numBits(0) {}
+
+	bool unpack(byte *target, uint32 targetSize);
+
+private:
+	void refill();
+
+	uint32 getBits(int n) {
+		if (_numBits < n)
+			refill();
+		uint32 ret = (uint32)_bits & ((1 << n) - 1);
+		_bits >>= n;
+		_numBits -= n;
+		return ret;
+	}
+
+	/**
+	 * Decode one Huffman code with a table built by buildLookupTable().
+	 */
+	int huffmanLookup(const uint16 *table, int maxBits) {
+		if (_numBits < maxBits)
+			refill();
+		uint16 entry = table[_bits & ((1 << maxBits) - 1)];
+		_bits >>= entry >> 8;
+		_numBits -= entry >> 8;
+		return entry & 0xFF;
+	}
+
+	static void buildLookupTable(const int *tree, uint16 *table, int maxBits);
+	static void initLookupTables();
+
+	static uint16 _lengthTable[1 << LENGTH_TREE_BITS];
+	static uint16 _distanceTable[1 << DISTANCE_TREE_BITS];
+	static uint16 _asciiTable[1 << ASCII_TREE_BITS];
+	static bool _lookupTablesInitialized;
+
+	const byte *_source;
+	const byte *_sourceEnd;
+	uint64 _bits;			///< bits buffer, the next bit to read is the lowest one
+	int _numBits;			///< number of unread bits in _bits
+};
+
+uint16 MemoryDecompressorDCL::_lengthTable[1 << LENGTH_TREE_BITS];
+uint16 MemoryDecompressorDCL::_distanceTable[1 << DISTANCE_TREE_BITS];
+uint16 MemoryDecompressorDCL::_asciiTable[1 << ASCII_TREE_BITS];
+bool MemoryDecompressorDCL::_lookupTablesInitialized = false;
+
+void MemoryDecompressorDCL::buildLookupTable(const int *tree, uint16 *table, int maxBits) {
+	// Every entry holds the length of the code in the high byte and the
+	// decoded value in the low byte, so that codes shorter than maxBits
+	// fill all entries which start with their bits
+	for (int code = 0; code < (1 << maxBits); code++) {
+		int pos = 0;
+		int length = 0;
+
+		while (!(tree[pos] & HUFFMAN_LEAF)) {
+			pos = ((code >> length) & 1) ? tree[pos] & 0xFFF : tree[pos] >> 12;
+			length++;
+		}
+
+		assert(length <= maxBits);
+		table[code] = (length << 8) | (tree[pos] & 0xFF);
+	}
+}
+
+void MemoryDecompressorDCL::initLookupTables() {
+	if (_lookupTablesInitialized)
+		return;
+
+	buildLookupTable(length_tree, _lengthTable, LENGTH_TREE_BITS);
+	buildLookupTable(distance_tree, _distanceTable, DISTANCE_TREE_BITS);
+	buildLookupTable(ascii_tree, _asciiTable, ASCII_TREE_BITS);
+	_lookupTablesInitialized = true;
+}
+
+void MemoryDecompressorDCL::refill() {
+	if (_sourceEnd - _source >= 8) {
+		// Bits of a partially consumed byte are OR'ed in again at the same
+		// position, so they do not need to be masked out
+		uint64 word = READ_LE_UINT32(_source) | ((uint64)READ_LE_UINT32(_source + 4) << 32);
+		_bits |= word << _numBits;
+		_source += (63 - _numBits) >> 3;
+		_numBits |= 56;
+	} else {
+		// Like the stream based decompressor, read zeros past the end
+		while (_numBits <= 56) {
+			if (_source < _sourceEnd)
+				_bits |= (uint64)*_source++ << _numBits;
+			_numBits += 8;
+		}
+	}
+}
+
+bool MemoryDecompressorDCL::unpack(byte *target, uint32 targetSize) {
+	uint32 bytesWritten = 0;
+
+	initLookupTables();
+
+	byte mode = getBits(8);
+	byte dictionaryType = getBits(8);
+
+	if (mode != DCL_BINARY_MODE && mode != DCL_ASCII_MODE) {
+		warning("DCL-INFLATE: Error: Encountered mode %02x, expected 00 or 01", mode);
+		return false;
+	}
+
+	// Matches are copied straight from the target buffer. Their offset can
+	// not exceed the dictionary size, so this gives the same result as
+	// copying from the dictionary.
+	if (dictionaryType < 4 || dictionaryType > 6) {
+		warning("DCL-INFLATE: Error: unsupported dictionary type %02x", dictionaryType);
+		return false;
+	}
+
+	while (bytesWritten < targetSize) {
+		if (getBits(1)) { // (length,distance) pair
+			int value = huffmanLookup(_lengthTable, LENGTH_TREE_BITS);
+			uint32 tokenLength;
+
+			if (value < 8)
+				tokenLength = value + 2;
+			else
+				tokenLength = 8 + (1 << (value - 7)) + getBits(value - 7);
+
+			if (tokenLength == 519)
+				break; // End of stream signal
+
+			value = huffmanLookup(_distanceTable, DISTANCE_TREE_BITS);
+
+			uint32 tokenOffset;
+			if (tokenLength == 2)
+				tokenOffset = (value << 2) | getBits(2);
+			else
+				tokenOffset = (value << dictionaryType) | getBits(dictionaryType);
+			tokenOffset++;
+
+			if (tokenLength + bytesWritten > targetSize) {
+				warning("DCL-INFLATE Error: Write out of bounds while copying %d bytes (declared unpacked size is %d bytes, current is %d + %d bytes)",
+						tokenLength, targetSize, bytesWritten, tokenLength);
+				return false;
+			}
+
+			if (bytesWritten < tokenOffset) {
+				warning("DCL-INFLATE Error: Attempt to copy from before beginning of input stream (declared unpacked size is %d bytes, current is %d bytes)",
+						targetSize, bytesWritten);
+				return false;
+			}
+
+			byte *dest = target + bytesWritten;
+			const byte *src = dest - tokenOffset;
+			bytesWritten += tokenLength;
+
+			if (tokenOffset >= tokenLength) {
+				memcpy(dest, src, tokenLength);
+			} else {
+				// The match overlaps the bytes it produces
+				while (tokenLength--)
+					*dest++ = *src++;
+			}
+		} else { // Copy byte verbatim
+			target[bytesWritten++] = (mode == DCL_ASCII_MODE) ? huffmanLookup(_asciiTable, ASCII_TREE_BITS) : getBits(8);
+		}
+	}
+
+	if (bytesWritten != targetSize)
+		warning("DCL-INFLATE Error: Inconsistent bytes written (%d) and target buffer size (%d)", bytesWritten, targetSize);
+	return bytesWritten == targetSize;
+}
+
 bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpackedSize) {
 	bool success = false;
-	DecompressorDCL dcl;
 
 	if (!src || !dest)
 		return false;
@@ -468,14 +653,11 @@ bool decompressDCL(ReadStream *src, byte *dest, uint32 packedSize, uint32 unpack
 		return false;
 
 	// Read source into memory
-	src->read(sourceBufferPtr, packedSize);
-
-	Common::MemoryReadStream  *sourceStream = new MemoryReadStream(sourceBufferPtr, packedSize, DisposeAfterUse::YES);
-	Common::MemoryWriteStream *targetStream = new MemoryWriteStream(dest, unpackedSize);
+	uint32 bytesRead = src->read(sourceBufferPtr, packedSize);
 
-	success = dcl.unpack(sourceStream, targetStream, unpackedSize, true);
-	delete sourceStream;
-	delete targetStream;
+	MemoryDecompressorDCL dcl(sourceBufferPtr, bytesRead);
+	success = dcl.unpack(dest, unpackedSize);
+	free(sourceBufferPtr);
 	return success;
 }
 
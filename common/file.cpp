@@ -70,7 +70,7 @@ bool File::open(const FSNode &node) {
 		return false;
 	}
 
-	SeekableReadStream *stream = node.createReadStream();
+	SeekableReadStream *stream = node.createDataReadStream();
 	return open(stream, node.getPath());
 }
 
@@ -138,6 +138,11 @@ bool File::seek(int32 offs, int whence) {
 	return _handle->seek(offs, whence);
 }
 
+const byte *File::getData() const {
+	assert(_handle);
+	return _handle->getData();
+}
+
 uint32 File::read(void *ptr, uint32 len) {
 	assert(_handle);
 	return _handle->read(ptr, len);
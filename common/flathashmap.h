@@ -0,0 +1,618 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+// For Hash<>, EqualTo<>, and the DEBUG_HASH_COLLISIONS switch
+#include "common/hashmap.h"
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val> which
+ * stores its entries inline in one contiguous array instead of allocating
+ * a separate node for every entry.
+ *
+ * Collisions are resolved with linear probing. Next to the entry array a
+ * small array of control bytes is kept: one byte per slot, holding either
+ * a marker for empty/erased slots, or seven bits of the hash of the key
+ * stored in that slot. Lookups mostly scan these control bytes and only
+ * compare keys whose hash bits match, which keeps the common case within
+ * one or two cache lines.
+ *
+ * Erased slots are turned back into empty slots whenever this does not
+ * break a probe sequence, and the remaining ones are purged by an in-place
+ * rehash before they can noticeably degrade lookups.
+ *
+ * The API is identical to the one of HashMap, with one important
+ * difference: since entries are stored inline, inserting a new key may move
+ * all entries around. Hence references and pointers to keys or values
+ * are invalidated by any operation which inserts a new key, just like
+ * iterators are. Erasing an entry (also while iterating) does not move any
+ * of the remaining entries.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> HM_t;
+
+	struct Node {
+		const Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+		Node(const Key &key, const Val &value) : _key(key), _value(value) {}
+	};
+
+	enum {
+		HASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage of the hashmap may fill up (including erased
+		// slots) before being rehashed.
+		// Note: the quotient of these two must be between and different
+		// from 0 and 1.
+		HASHMAP_LOADFACTOR_NUMERATOR = 3,
+		HASHMAP_LOADFACTOR_DENOMINATOR = 4
+	};
+
+	enum {
+		kSlotEmpty = 0x80,  ///< Slot was never used (ends a probe sequence)
+		kSlotErased = 0xFE  ///< Slot held an entry which got erased
+		// Used slots hold the lower seven bits of the hash fragment
+	};
+
+	byte *_ctrl;        ///< control bytes, one per slot
+	Node *_storage;     ///< uninitialized storage for _mask+1 nodes
+	size_type _mask;    ///< Capacity of the HashMap minus one; must be a power of two of minus one
+	size_type _size;
+	size_type _deleted; ///< Number of erased slots
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+#ifdef DEBUG_HASH_COLLISIONS
+	mutable int _collisions, _lookups, _dummyHits;
+#endif
+
+	/**
+	 * Scramble the user supplied hash. Many of our hash functions (for
+	 * example the one for integers) return values which are not evenly
+	 * distributed over the lower bits, which linear probing is very
+	 * sensitive to.
+	 */
+	static size_type mixHash(size_type hash) {
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6B;
+		hash ^= hash >> 13;
+		return hash;
+	}
+
+	static byte hashFragment(size_type hash) {
+		return (byte)((hash >> 25) & 0x7F);
+	}
+
+	static bool isUsed(byte ctrl) {
+		return (ctrl & 0x80) == 0;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const HM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+	void eraseSlot(size_type ctr);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != 0);
+			assert(_idx <= _hashmap->_mask);
+			assert(isUsed(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_storage[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(0) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextUsed(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/**
+	 * Return the index of the first used slot at or after the given one,
+	 * or (size_type)-1 if there is none.
+	 */
+	size_type nextUsed(size_type ctr) const {
+		for (; ctr <= _mask; ++ctr) {
+			if (isUsed(_ctrl[ctr]))
+				return ctr;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const HM_t &map);
+	~FlatHashMap();
+
+	HM_t &operator=(const HM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		return iterator(nextUsed(0), this);
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextUsed(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		size_type ctr = lookup(key);
+		if (isUsed(_ctrl[ctr]))
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		size_type ctr = lookup(key);
+		if (isUsed(_ctrl[ctr]))
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(HASHMAP_MIN_CAPACITY);
+
+	_size = 0;
+	_deleted = 0;
+
+#ifdef DEBUG_HASH_COLLISIONS
+	_collisions = 0;
+	_lookups = 0;
+	_dummyHits = 0;
+#endif
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const HM_t &map) :
+	_defaultVal() {
+#ifdef DEBUG_HASH_COLLISIONS
+	_collisions = 0;
+	_lookups = 0;
+	_dummyHits = 0;
+#endif
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+#ifdef DEBUG_HASH_COLLISIONS
+	extern void updateHashCollisionStats(int, int, int, int, int, bool);
+	updateHashCollisionStats(_collisions, _dummyHits, _lookups, _mask+1, _size, true);
+#endif
+}
+
+/**
+ * Internal method for allocating empty storage of the given capacity.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_ctrl = new byte[capacity];
+	assert(_ctrl != NULL);
+	memset(_ctrl, kSlotEmpty, capacity);
+	_storage = (Node *)malloc(capacity * sizeof(Node));
+	assert(_storage != NULL);
+}
+
+/**
+ * Internal method for releasing the storage. All nodes must already
+ * have been destroyed.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	delete[] _ctrl;
+	free(_storage);
+	_ctrl = NULL;
+	_storage = NULL;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const HM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Clone the map slot by slot, which keeps all probe sequences intact.
+	memcpy(_ctrl, map._ctrl, _mask + 1);
+	_size = 0;
+	_deleted = map._deleted;
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr])) {
+			new ((void *)&_storage[ctr]) Node(map._storage[ctr]._key, map._storage[ctr]._value);
+			_size++;
+		}
+	}
+	// Perform a sanity check (to help track down hashmap corruption)
+	assert(_size == map._size);
+}
+
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr]))
+			_storage[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask >= HASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(HASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, kSlotEmpty, _mask + 1);
+	}
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity * HASHMAP_LOADFACTOR_NUMERATOR > _size * HASHMAP_LOADFACTOR_DENOMINATOR);
+
+#ifndef NDEBUG
+	const size_type old_size = _size;
+#endif
+	const size_type old_mask = _mask;
+	byte *old_ctrl = _ctrl;
+	Node *old_storage = _storage;
+
+	// allocate new arrays
+	_size = 0;
+	_deleted = 0;
+	allocStorage(newCapacity);
+
+	// move all the old elements over
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (!isUsed(old_ctrl[ctr]))
+			continue;
+
+		// Since we know that no key exists twice in the old table and the
+		// new one contains no erased slots, we can simply take the first
+		// empty slot without calling _equal().
+		const size_type hash = mixHash(_hash(old_storage[ctr]._key));
+		size_type idx = hash & _mask;
+		while (_ctrl[idx] != kSlotEmpty)
+			idx = (idx + 1) & _mask;
+
+		_ctrl[idx] = hashFragment(hash);
+		new ((void *)&_storage[idx]) Node(old_storage[ctr]._key, old_storage[ctr]._value);
+		old_storage[ctr].~Node();
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+
+	delete[] old_ctrl;
+	free(old_storage);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const size_type hash = mixHash(_hash(key));
+	const byte fragment = hashFragment(hash);
+	size_type ctr = hash & _mask;
+	for (;;) {
+		const byte ctrl = _ctrl[ctr];
+		if (ctrl == kSlotEmpty)
+			break;
+		if (ctrl == kSlotErased) {
+#ifdef DEBUG_HASH_COLLISIONS
+			_dummyHits++;
+#endif
+		} else if (ctrl == fragment && _equal(_storage[ctr]._key, key))
+			break;
+
+		ctr = (ctr + 1) & _mask;
+
+#ifdef DEBUG_HASH_COLLISIONS
+		_collisions++;
+#endif
+	}
+
+#ifdef DEBUG_HASH_COLLISIONS
+	_lookups++;
+	debug("collisions %d, dummies hit %d, lookups %d, ratio %f in FlatHashMap %p; size %d num elements %d",
+		_collisions, _dummyHits, _lookups, ((double) _collisions / (double)_lookups),
+		(const void *)this, _mask+1, _size);
+#endif
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type hash = mixHash(_hash(key));
+	const byte fragment = hashFragment(hash);
+	size_type ctr = hash & _mask;
+	const size_type NONE_FOUND = _mask + 1;
+	size_type first_free = NONE_FOUND;
+	for (;;) {
+		const byte ctrl = _ctrl[ctr];
+		if (ctrl == kSlotEmpty)
+			break;
+		if (ctrl == kSlotErased) {
+#ifdef DEBUG_HASH_COLLISIONS
+			_dummyHits++;
+#endif
+			if (first_free == NONE_FOUND)
+				first_free = ctr;
+		} else if (ctrl == fragment && _equal(_storage[ctr]._key, key)) {
+#ifdef DEBUG_HASH_COLLISIONS
+			_lookups++;
+#endif
+			return ctr;
+		}
+
+		ctr = (ctr + 1) & _mask;
+
+#ifdef DEBUG_HASH_COLLISIONS
+		_collisions++;
+#endif
+	}
+
+#ifdef DEBUG_HASH_COLLISIONS
+	_lookups++;
+	debug("collisions %d, dummies hit %d, lookups %d, ratio %f in FlatHashMap %p; size %d num elements %d",
+		_collisions, _dummyHits, _lookups, ((double) _collisions / (double)_lookups),
+		(const void *)this, _mask+1, _size);
+#endif
+
+	// Reusing an erased slot never increases the load of the table.
+	if (first_free != NONE_FOUND) {
+		ctr = first_free;
+		_deleted--;
+	} else {
+		// Keep the load factor below a certain threshold. Erased slots are
+		// also counted, but if they make up a large part of the load we
+		// simply purge them instead of growing the table.
+		size_type capacity = _mask + 1;
+		if ((_size + _deleted + 1) * HASHMAP_LOADFACTOR_DENOMINATOR >
+		        capacity * HASHMAP_LOADFACTOR_NUMERATOR) {
+			if ((_size + 1) * HASHMAP_LOADFACTOR_DENOMINATOR * 2 > capacity * HASHMAP_LOADFACTOR_NUMERATOR)
+				capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
+			rehash(capacity);
+
+			ctr = hash & _mask;
+			while (_ctrl[ctr] != kSlotEmpty)
+				ctr = (ctr + 1) & _mask;
+		}
+	}
+
+	_ctrl[ctr] = fragment;
+	new ((void *)&_storage[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	size_type ctr = lookup(key);
+	return isUsed(_ctrl[ctr]);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	assert(isUsed(_ctrl[ctr]));
+	return _storage[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (isUsed(_ctrl[ctr]))
+		return _storage[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	assert(isUsed(_ctrl[ctr]));
+	_storage[ctr]._value = val;
+}
+
+/**
+ * Internal method for removing the node in the given slot.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type ctr) {
+	_storage[ctr].~Node();
+	_size--;
+
+	// If the following slot is empty, no probe sequence can pass through
+	// this slot, so it (and any erased slots directly before it) can be
+	// marked as empty right away. Otherwise we have to leave a marker.
+	if (_ctrl[(ctr + 1) & _mask] != kSlotEmpty) {
+		_ctrl[ctr] = kSlotErased;
+		_deleted++;
+		return;
+	}
+
+	_ctrl[ctr] = kSlotEmpty;
+	ctr = (ctr - 1) & _mask;
+	while (_ctrl[ctr] == kSlotErased) {
+		_ctrl[ctr] = kSlotEmpty;
+		_deleted--;
+		ctr = (ctr - 1) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(isUsed(_ctrl[ctr]));
+
+	eraseSlot(ctr);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (!isUsed(_ctrl[ctr]))
+		return;
+
+	eraseSlot(ctr);
+}
+
+} // End of namespace Common
+
+#endif
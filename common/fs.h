@@ -222,6 +222,16 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Creates a SeekableReadStream instance for reading game data from the
+	 * file referred by this node. This may be faster than createReadStream(),
+	 * but the file must not be modified while the stream is open. Thus this
+	 * must not be used for files which are written to, like savegames.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual SeekableReadStream *createDataReadStream() const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
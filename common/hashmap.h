@@ -354,8 +354,8 @@ HashMap<Key, Val, HashFunc, EqualFunc>::~HashMap() {
 
 	delete[] _storage;
 #ifdef DEBUG_HASH_COLLISIONS
-	extern void updateHashCollisionStats(int, int, int, int, int);
-	updateHashCollisionStats(_collisions, _dummyHits, _lookups, _mask+1, _size);
+	extern void updateHashCollisionStats(int, int, int, int, int, bool);
+	updateHashCollisionStats(_collisions, _dummyHits, _lookups, _mask+1, _size, false);
 #endif
 }
 
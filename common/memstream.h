@@ -64,6 +64,8 @@ public:
 
 	uint32 read(void *dataPtr, uint32 dataSize);
 
+	const byte *getData() const { return _ptrOrig; }
+
 	bool eos() const { return _eos; }
 	void clearErr() { _eos = false; }
 
@@ -527,6 +527,20 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Returns a pointer to the complete contents of the stream, if these
+	 * are directly accessible in memory (e.g. for a MemoryReadStream, or
+	 * a memory mapped file). Callers can use this to access the data
+	 * without copying it into a buffer of their own.
+	 *
+	 * The pointer stays valid until the stream is deleted. It does not
+	 * depend on the stream position indicator.
+	 *
+	 * @return a pointer to size() bytes of stream data, or 0 if the data
+	 *         is not directly accessible
+	 */
+	virtual const byte *getData() const { return 0; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
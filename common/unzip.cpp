@@ -107,7 +107,7 @@ typedef struct {
 #include "common/unzip.h"
 #include "common/memstream.h"
 
-#include "common/hashmap.h"
+#include "common/flathashmap.h"
 #include "common/hash-str.h"
 
 #if defined(STRICTUNZIP) || defined(STRICTZIPUNZIP)
@@ -375,7 +375,7 @@ typedef struct {
 	unz_file_info_internal cur_file_info_internal;	/* private info about it*/
 } cached_file_in_zip;
 
-typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_Hash,
+typedef Common::FlatHashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_Hash,
 	Common::IgnoreCase_EqualTo> ZipHash;
 
 /* unz_s contain internal information about the zipfile
@@ -517,6 +517,91 @@ static uLong unzlocal_SearchCentralDir(Common::SeekableReadStream &fin) {
 	return uPosFound;
 }
 
+static void unzlocal_DosDateToTmuDate(uLong ulDosDate, tm_unz* ptm);
+
+/*
+  Read the whole central directory with a single read and store the
+  details of all files in it in the hash.
+  This is much faster than walking the central directory with
+  unzGoToFirstFile/unzGoToNextFile, which needs a seek and about twenty
+  small reads per file, and hurts on slow storage for archives with
+  thousands of files.
+  On return, the last file found is the current file, just like after
+  walking the central directory.
+*/
+static int unzlocal_BuildHash(unz_s *s) {
+	const uLong size = s->size_central_dir;
+	byte *buf = (byte *)malloc(size ? size : 1);
+	if (buf == NULL)
+		return UNZ_INTERNALERROR;
+
+	s->_stream->seek(s->offset_central_dir + s->byte_before_the_zipfile, SEEK_SET);
+	if (s->_stream->err() || s->_stream->read(buf, size) != size) {
+		free(buf);
+		return UNZ_ERRNO;
+	}
+
+	s->current_file_ok = 0;
+
+	uLong pos = 0;
+	for (uLong num = 0; num < s->gi.number_entry; ++num) {
+		if (pos + SIZECENTRALDIRITEM > size)
+			break;
+
+		const byte *item = buf + pos;
+		if (READ_LE_UINT32(item) != 0x02014b50)
+			break;
+
+		cached_file_in_zip fe;
+		unz_file_info &file_info = fe.cur_file_info;
+		file_info.version = READ_LE_UINT16(item + 4);
+		file_info.version_needed = READ_LE_UINT16(item + 6);
+		file_info.flag = READ_LE_UINT16(item + 8);
+		file_info.compression_method = READ_LE_UINT16(item + 10);
+		file_info.dosDate = READ_LE_UINT32(item + 12);
+		unzlocal_DosDateToTmuDate(file_info.dosDate, &file_info.tmu_date);
+		file_info.crc = READ_LE_UINT32(item + 16);
+		file_info.compressed_size = READ_LE_UINT32(item + 20);
+		file_info.uncompressed_size = READ_LE_UINT32(item + 24);
+		file_info.size_filename = READ_LE_UINT16(item + 28);
+		file_info.size_file_extra = READ_LE_UINT16(item + 30);
+		file_info.size_file_comment = READ_LE_UINT16(item + 32);
+		file_info.disk_num_start = READ_LE_UINT16(item + 34);
+		file_info.internal_fa = READ_LE_UINT16(item + 36);
+		file_info.external_fa = READ_LE_UINT32(item + 38);
+		fe.cur_file_info_internal.offset_curfile = READ_LE_UINT32(item + 42);
+
+		if (pos + SIZECENTRALDIRITEM + file_info.size_filename > size)
+			break;
+
+		fe.num_file = num;
+		fe.pos_in_central_dir = s->offset_central_dir + pos;
+		fe.current_file_ok = 1;
+
+		// Names are cut off at UNZ_MAXFILENAMEINZIP characters, and at
+		// the first NUL character if there is one.
+		const char *name = (const char *)item + SIZECENTRALDIRITEM;
+		uLong nameLength = MIN<uLong>(file_info.size_filename, UNZ_MAXFILENAMEINZIP);
+		const char *nul = (const char *)memchr(name, 0, nameLength);
+		if (nul)
+			nameLength = nul - name;
+
+		s->_hash[Common::String(name, nameLength)] = fe;
+
+		s->num_file = fe.num_file;
+		s->pos_in_central_dir = fe.pos_in_central_dir;
+		s->current_file_ok = fe.current_file_ok;
+		s->cur_file_info = fe.cur_file_info;
+		s->cur_file_info_internal = fe.cur_file_info_internal;
+
+		pos += SIZECENTRALDIRITEM + file_info.size_filename +
+			file_info.size_file_extra + file_info.size_file_comment;
+	}
+
+	free(buf);
+	return UNZ_OK;
+}
+
 /*
   Open a Zip file. path contain the full pathname (by example,
      on a Windows NT computer "c:\\test\\zlib109.zip" or on an Unix computer
@@ -605,27 +690,12 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	us->central_pos = central_pos;
 	us->pfile_in_zip_read = NULL;
 
-	err = unzGoToFirstFile((unzFile)us);
-
-	while (err == UNZ_OK) {
-		// Get the file details
-		char szCurrentFileName[UNZ_MAXFILENAMEINZIP+1];
-		unzGetCurrentFileInfo(us, NULL, szCurrentFileName, sizeof(szCurrentFileName) - 1,
-							NULL, 0, NULL, 0);
-
-		// Save details into the hash
-		cached_file_in_zip fe;
-		fe.num_file = us->num_file;
-		fe.pos_in_central_dir = us->pos_in_central_dir;
-		fe.current_file_ok = us->current_file_ok;
-		fe.cur_file_info = us->cur_file_info;
-		fe.cur_file_info_internal = us->cur_file_info_internal;
-
-		us->_hash[Common::String(szCurrentFileName)] = fe;
-
-		// Move to the next file
-		err = unzGoToNextFile((unzFile)us);
+	if (unzlocal_BuildHash(us) != UNZ_OK) {
+		delete us->_stream;
+		delete us;
+		return NULL;
 	}
+
 	return (unzFile)us;
 }
 
@@ -1422,9 +1492,10 @@ namespace Common {
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
+	bool _shareStoredData;
 
 public:
-	ZipArchive(unzFile zipFile);
+	ZipArchive(unzFile zipFile, bool shareStoredData);
 
 
 	~ZipArchive();
@@ -1453,7 +1524,7 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
+ZipArchive::ZipArchive(unzFile zipFile, bool shareStoredData) : _zipFile(zipFile), _shareStoredData(shareStoredData) {
 	assert(_zipFile);
 }
 
@@ -1489,11 +1560,29 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return 0;
 
-	unz_file_info fileInfo;
-	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
-		return 0;
+	// unzLocateFile already filled in the file details from the hash, so
+	// there is no need to read them from the central directory again.
+	unz_s *archive = (unz_s *)_zipFile;
+	const unz_file_info &fileInfo = archive->cur_file_info;
+
+	// Stored members of archives in memory can be read in place. Note that
+	// this skips the CRC check done by unzCloseCurrentFile().
+	const byte *archiveData = _shareStoredData ? archive->_stream->getData() : 0;
+	if (archiveData && fileInfo.compression_method == 0) {
+		uInt sizeVar;
+		uLong extraFieldOffset;
+		uInt extraFieldSize;
+		if (unzlocal_CheckCurrentFileCoherencyHeader(archive, &sizeVar, &extraFieldOffset, &extraFieldSize) != UNZ_OK)
+			return 0;
+
+		const uLong offset = archive->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + sizeVar + archive->byte_before_the_zipfile;
+		if (offset + fileInfo.uncompressed_size > (uLong)archive->_stream->size())
+			return 0;
+
+		return new MemoryReadStream(archiveData + offset, fileInfo.uncompressed_size);
+	}
 
-	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK)
+	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
 		return 0;
 
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
@@ -1517,15 +1606,15 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	// files in the archive and tries to use them independently.
 }
 
-Archive *makeZipArchive(const String &name) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name));
+Archive *makeZipArchive(const String &name, bool shareStoredData) {
+	return makeZipArchive(SearchMan.createReadStreamForMember(name), shareStoredData);
 }
 
-Archive *makeZipArchive(const FSNode &node) {
-	return makeZipArchive(node.createReadStream());
+Archive *makeZipArchive(const FSNode &node, bool shareStoredData) {
+	return makeZipArchive(node.createDataReadStream(), shareStoredData);
 }
 
-Archive *makeZipArchive(SeekableReadStream *stream) {
+Archive *makeZipArchive(SeekableReadStream *stream, bool shareStoredData) {
 	if (!stream)
 		return 0;
 	unzFile zipFile = unzOpen(stream);
@@ -1534,7 +1623,7 @@ Archive *makeZipArchive(SeekableReadStream *stream) {
 		// goes wrong.
 		return 0;
 	}
-	return new ZipArchive(zipFile);
+	return new ZipArchive(zipFile, shareStoredData);
 }
 
 } // End of namespace Common
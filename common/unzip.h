@@ -34,18 +34,20 @@ class SeekableReadStream;
 /**
  * This factory method creates an Archive instance corresponding to the content
  * of the ZIP compressed file with the given name.
+ * See below for the meaning of shareStoredData.
  *
  * May return 0 in case of a failure.
  */
-Archive *makeZipArchive(const String &name);
+Archive *makeZipArchive(const String &name, bool shareStoredData = false);
 
 /**
  * This factory method creates an Archive instance corresponding to the content
  * of the ZIP compressed file with the given name.
+ * See below for the meaning of shareStoredData.
  *
  * May return 0 in case of a failure.
  */
-Archive *makeZipArchive(const FSNode &node);
+Archive *makeZipArchive(const FSNode &node, bool shareStoredData = false);
 
 /**
  * This factory method creates an Archive instance corresponding to the content
@@ -53,9 +55,15 @@ Archive *makeZipArchive(const FSNode &node);
  * This takes ownership of the stream,  in particular, it is deleted when the
  * ZipArchive is deleted.
  *
+ * If shareStoredData is true and the stream data is directly accessible in
+ * memory (see SeekableReadStream::getData()), e.g. because the file is memory
+ * mapped, the streams of members which are stored uncompressed read from
+ * that memory instead of a copy. These must not be used after the archive
+ * has been deleted.
+ *
  * May return 0 in case of a failure. In this case stream will still be deleted.
  */
-Archive *makeZipArchive(SeekableReadStream *stream);
+Archive *makeZipArchive(SeekableReadStream *stream, bool shareStoredData = false);
 
 } // End of namespace Common
 
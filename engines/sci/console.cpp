@@ -113,6 +113,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	registerCmd("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
@@ -160,6 +161,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -221,6 +223,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("vm_profile",		WRAP_METHOD(Console, cmdVMProfile));
+	registerCmd("send_cache",		WRAP_METHOD(Console, cmdSendCache));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -252,6 +256,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.predecodeScripts = true;
 }
 
 Console::~Console() {
@@ -369,6 +374,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	debugPrintf(" resource_info - Shows info about a resource\n");
 	debugPrintf(" resource_types - Shows the valid resource types\n");
+	debugPrintf(" resource_cache - Shows or changes the resource cache size and statistics\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
@@ -411,6 +417,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows or resets garbage collection statistics\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -455,6 +462,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" vm_profile - Shows or resets opcode counts and time spent executing scripts\n");
+	debugPrintf(" send_cache - Shows or resets the hit rate of the selector lookup cache\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -1006,6 +1015,40 @@ bool Console::cmdResourceInfo(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetCacheStats();
+			debugPrintf("Resource cache statistics reset\n");
+			return true;
+		} else if (!scumm_stricmp(argv[1], "size") && argc > 2) {
+			const int size = atoi(argv[2]);
+			if (size > 0) {
+				resMan->setMaxMemory(size * 1024);
+				debugPrintf("Resource cache size set to %d KiB\n", size);
+				return true;
+			}
+		}
+
+		debugPrintf("Shows the size and statistics of the resource cache.\n");
+		debugPrintf("Usage: %s [reset | size <KiB>]\n", argv[0]);
+		debugPrintf("reset - resets the statistics\n");
+		debugPrintf("size - changes the number of KiB unlocked resources may use\n");
+		return true;
+	}
+
+	const ResourceManager::CacheStats &stats = resMan->getCacheStats();
+	const uint32 requests = stats.hits + stats.misses;
+	debugPrintf("Cached: %d of %d KiB, locked: %d KiB\n", resMan->getMemoryLRU() / 1024,
+	            resMan->getMaxMemory() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("Requests: %u, hits: %u (%.1f%%), misses: %u, evictions: %u\n", requests, stats.hits,
+	            requests ? 100.0 * stats.hits / requests : 0.0, stats.misses, stats.evictions);
+	debugPrintf("Prefetched: %u, used: %u\n", stats.prefetches, stats.prefetchHits);
+	return true;
+}
+
 bool Console::cmdResourceTypes(int argc, const char **argv) {
 	debugPrintf("The %d valid resource types are:\n", kResourceTypeInvalid);
 	for (int i = 0; i < kResourceTypeInvalid; i++) {
@@ -2498,6 +2541,30 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			_engine->_gamestate->_segMan->resetGCStatistics();
+			debugPrintf("Garbage collection statistics reset\n");
+		} else {
+			debugPrintf("Shows statistics about the garbage collections done so far.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const GCStatistics &stats = _engine->_gamestate->_segMan->getGCStatistics();
+	debugPrintf("Collections: %u, skipped: %u\n", stats.runs, stats.skipped);
+	debugPrintf("Pause time: last %u ms, max %u ms, total %u ms", stats.lastMillis, stats.maxMillis, stats.totalMillis);
+	if (stats.runs)
+		debugPrintf(", average %u ms", stats.totalMillis / stats.runs);
+	debugPrintf("\n");
+	debugPrintf("Last collection: %u live references, %u entries freed\n", stats.lastLive, stats.lastFreed);
+	debugPrintf("Entries freed in total: %u\n", stats.totalFreed);
+	debugPrintf("Allocations since last collection: %u\n", _engine->_gamestate->_segMan->getAllocationsSinceGC());
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3083,6 +3150,96 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMProfile(int argc, const char **argv) {
+	EngineState *s = _engine->_gamestate;
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			s->scriptStepCounter = 0;
+			memset(s->scriptOpcodeCounters, 0, sizeof(s->scriptOpcodeCounters));
+			s->scriptMillis = 0;
+			debugPrintf("Profiling data reset\n");
+			return true;
+		} else if (!scumm_stricmp(argv[1], "predecode") && argc > 2 &&
+		           (!scumm_stricmp(argv[2], "on") || !scumm_stricmp(argv[2], "off"))) {
+			_debugState.predecodeScripts = !scumm_stricmp(argv[2], "on");
+			debugPrintf("Instruction predecoding is now %s\n", _debugState.predecodeScripts ? "on" : "off");
+			return true;
+		}
+
+		debugPrintf("Shows opcode counts and the time spent executing scripts.\n");
+		debugPrintf("Usage: %s [reset | predecode on|off]\n", argv[0]);
+		debugPrintf("reset - resets the profiling data\n");
+		debugPrintf("predecode on|off - toggles the cache of decoded instructions\n");
+		return true;
+	}
+
+	uint32 total = 0;
+	for (int i = 0; i < 128; ++i)
+		total += s->scriptOpcodeCounters[i];
+
+	debugPrintf("Executed SCI operations: %u in %u ms", total, s->scriptMillis);
+	if (s->scriptMillis)
+		debugPrintf(" (%u per ms)", total / s->scriptMillis);
+	debugPrintf("\n");
+	debugPrintf("Instruction predecoding: %s\n", _debugState.predecodeScripts ? "on" : "off");
+
+	if (!total)
+		return true;
+
+	// Show the ten most executed opcodes
+	bool shown[128];
+	memset(shown, 0, sizeof(shown));
+	debugPrintf("Most executed opcodes:\n");
+	for (int n = 0; n < 10; ++n) {
+		int best = -1;
+		for (int i = 0; i < 128; ++i) {
+			if (!shown[i] && s->scriptOpcodeCounters[i] && (best == -1 || s->scriptOpcodeCounters[i] > s->scriptOpcodeCounters[best]))
+				best = i;
+		}
+		if (best == -1)
+			break;
+		shown[best] = true;
+#ifndef REDUCE_MEMORY_USAGE
+		debugPrintf(" %-8s %10u (%.1f%%)\n", opcodeNames[best], s->scriptOpcodeCounters[best],
+		            100.0 * s->scriptOpcodeCounters[best] / total);
+#else
+		debugPrintf(" op %02x    %10u (%.1f%%)\n", best, s->scriptOpcodeCounters[best],
+		            100.0 * s->scriptOpcodeCounters[best] / total);
+#endif
+	}
+
+	return true;
+}
+
+bool Console::cmdSendCache(int argc, const char **argv) {
+	SendCache &cache = _engine->_gamestate->_segMan->getSendCache();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			cache.resetStats();
+			debugPrintf("Selector lookup cache statistics reset\n");
+		} else if (!scumm_stricmp(argv[1], "clear")) {
+			cache.invalidate();
+			debugPrintf("Selector lookup cache cleared\n");
+		} else {
+			debugPrintf("Shows the hit rate of the selector lookup cache used by sends.\n");
+			debugPrintf("Usage: %s [reset | clear]\n", argv[0]);
+			debugPrintf("reset - resets the statistics\n");
+			debugPrintf("clear - drops all cached lookups\n");
+		}
+		return true;
+	}
+
+	const SendCache::Stats &stats = cache.getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	debugPrintf("Call sites: %u\n", cache.getNumSites());
+	debugPrintf("Lookups: %u, hits: %u (%.1f%%), misses: %u\n", lookups, stats.hits,
+	            lookups ? 100.0 * stats.hits / lookups : 0.0, stats.misses);
+	debugPrintf("Replaced receivers: %u, invalidations: %u\n", stats.replacements, stats.invalidations);
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
@@ -3666,7 +3823,7 @@ bool Console::cmdSend(int argc, const char **argv) {
 	old_xstack = &_engine->_gamestate->_executionStack.back();
 	xstack = send_selector(_engine->_gamestate, object, object,
 	                       stackframe + 2 + send_argc,
-	                       2 + send_argc, stackframe);
+	                       2 + send_argc, stackframe, make_reg32(0, 0));
 
 	bool restore_acc = old_xstack != xstack || argc == 3;
 
@@ -84,6 +84,7 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	bool predecodeScripts;       //< Execute cached, pre-decoded instructions instead of parsing them each time
 
 	void updateActiveBreakpointTypes();
 };
@@ -635,75 +635,127 @@ int DecompressorDCL::unpack(Common::ReadStream *src, byte *dest, uint32 nPacked,
 // Based on Andre Beck's code from http://micky.ibh.de/~beck/stuff/lzs4i4l/
 //----------------------------------------------
 int DecompressorLZS::unpack(Common::ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked) {
-	init(src, dest, nPacked, nUnpacked);
-	return unpackLZS();
+	_packedData.resize(nPacked);
+	const uint32 bytesRead = nPacked ? src->read(&_packedData[0], nPacked) : 0;
+	return unpackLZS(bytesRead ? &_packedData[0] : nullptr, bytesRead, dest, nUnpacked);
 }
 
-int DecompressorLZS::unpackLZS() {
-	uint16 offs = 0;
-	uint32 clen;
+namespace {
 
-	while (!isFinished()) {
-		if (getBitsMSB(1)) { // Compressed bytes follow
-			if (getBitsMSB(1)) { // Seven bit offset follows
-				offs = getBitsMSB(7);
-				if (!offs) // This is the end marker - a 7 bit offset of zero
-					break;
-				if (!(clen = getCompLen())) {
-					warning("lzsDecomp: length mismatch");
-					return SCI_ERROR_DECOMPRESSION_ERROR;
-				}
-				copyComp(offs, clen);
-			} else { // Eleven bit offset follows
-				offs = getBitsMSB(11);
-				if (!(clen = getCompLen())) {
-					warning("lzsDecomp: length mismatch");
-					return SCI_ERROR_DECOMPRESSION_ERROR;
-				}
-				copyComp(offs, clen);
+/**
+ * MSB-first bit reader for data in memory. Unread bits are kept at the top
+ * of a 64-bit buffer, which is refilled with up to seven bytes at once.
+ */
+class LZSBitReader {
+public:
+	LZSBitReader(const byte *src, uint32 size) :
+		_src(src), _srcEnd(src + size), _bits(0), _numBits(0) {}
+
+	uint32 peekBits(int n) {
+		if (_numBits < n)
+			refill();
+		return (uint32)(_bits >> (64 - n));
+	}
+
+	void skipBits(int n) {
+		_bits <<= n;
+		_numBits -= n;
+	}
+
+	uint32 getBits(int n) {
+		const uint32 value = peekBits(n);
+		skipBits(n);
+		return value;
+	}
+
+private:
+	void refill() {
+		if (_srcEnd - _src >= 8) {
+			// Bits of a partially consumed byte are OR'ed in again at the
+			// same position, so they do not need to be masked out
+			const uint64 word = ((uint64)READ_BE_UINT32(_src) << 32) | READ_BE_UINT32(_src + 4);
+			_bits |= word >> _numBits;
+			_src += (63 - _numBits) >> 3;
+			_numBits |= 56;
+		} else {
+			while (_numBits <= 56) {
+				if (_src < _srcEnd)
+					_bits |= (uint64)*_src++ << (56 - _numBits);
+				_numBits += 8;
 			}
-		} else // Literal byte follows
-			putByte(getByteMSB());
-	} // end of while ()
-	return _dwWrote == _szUnpacked ? 0 : SCI_ERROR_DECOMPRESSION_ERROR;
-}
+		}
+	}
 
-uint32 DecompressorLZS::getCompLen() {
-	uint32 clen;
-	int nibble;
-	// The most probable cases are hardcoded
-	switch (getBitsMSB(2)) {
-	case 0:
-		return 2;
-	case 1:
-		return 3;
-	case 2:
-		return 4;
-	default:
-		switch (getBitsMSB(2)) {
-		case 0:
-			return 5;
-		case 1:
-			return 6;
-		case 2:
-			return 7;
-		default:
-		// Ok, no shortcuts anymore - just get nibbles and add up
+	const byte *_src;
+	const byte *_srcEnd;
+	uint64 _bits;
+	int _numBits;
+};
+
+/**
+ * Lengths of the short match length codes, indexed by the next four bits:
+ * 00 -> 2, 01 -> 3, 10 -> 4, 1100 -> 5, 1101 -> 6, 1110 -> 7. The high byte
+ * holds the number of bits of the code. 1111 is followed by nibbles which
+ * are added to 8 and is marked with a length of zero.
+ */
+static const uint16 s_lzsLengthCodes[16] = {
+	0x202, 0x202, 0x202, 0x202, 0x203, 0x203, 0x203, 0x203,
+	0x204, 0x204, 0x204, 0x204, 0x405, 0x406, 0x407, 0x400
+};
+
+} // End of anonymous namespace
+
+int DecompressorLZS::unpackLZS(const byte *src, uint32 nPacked, byte *dest, uint32 nUnpacked) {
+	LZSBitReader bits(src, nPacked);
+	uint32 written = 0;
+
+	while (written < nUnpacked) {
+		if (!bits.getBits(1)) { // Literal byte follows
+			dest[written++] = bits.getBits(8);
+			continue;
+		}
+
+		// Compressed bytes follow
+		uint32 offs;
+		if (bits.getBits(1)) { // Seven bit offset follows
+			offs = bits.getBits(7);
+			if (!offs) // This is the end marker - a 7 bit offset of zero
+				break;
+		} else { // Eleven bit offset follows
+			offs = bits.getBits(11);
+		}
+
+		const uint16 code = s_lzsLengthCodes[bits.peekBits(4)];
+		bits.skipBits(code >> 8);
+		uint32 clen = code & 0xff;
+		if (!clen) {
+			// Ok, no shortcuts anymore - just get nibbles and add up
+			uint32 nibble;
 			clen = 8;
 			do {
-				nibble = getBitsMSB(4);
+				nibble = bits.getBits(4);
 				clen += nibble;
 			} while (nibble == 0xf);
-			return clen;
 		}
-	}
-}
 
-void DecompressorLZS::copyComp(int offs, uint32 clen) {
-	int hpos = _dwWrote - offs;
+		if (offs > written || clen > nUnpacked - written) {
+			warning("lzsDecomp: invalid match (offset %d, length %d) at %d of %d", offs, clen, written, nUnpacked);
+			return SCI_ERROR_DECOMPRESSION_ERROR;
+		}
+
+		byte *out = dest + written;
+		const byte *hist = out - offs;
+		written += clen;
+		if (offs >= clen) {
+			memcpy(out, hist, clen);
+		} else {
+			// The match overlaps the bytes it produces
+			while (clen--)
+				*out++ = *hist++;
+		}
+	}
 
-	while (clen--)
-		putByte(_dest[hpos++]);
+	return written == nUnpacked ? 0 : SCI_ERROR_DECOMPRESSION_ERROR;
 }
 
 #endif	// #ifdef ENABLE_SCI32
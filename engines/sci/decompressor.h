@@ -24,6 +24,7 @@
 #define SCI_DECOMPRESSOR_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 
 namespace Common {
 class ReadStream;
@@ -188,9 +189,19 @@ class DecompressorLZS : public Decompressor {
 public:
 	int unpack(Common::ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked);
 protected:
-	int unpackLZS();
-	uint32 getCompLen();
-	void copyComp(int offs, uint32 clen);
+	/**
+	 * Decompresses LZS data which is completely in memory. The bits are
+	 * fetched from a 64-bit buffer which is refilled several bytes at a
+	 * time, instead of one bit at a time from the source stream.
+	 * Bits past the end of the packed data read as zero.
+	 */
+	int unpackLZS(const byte *src, uint32 nPacked, byte *dest, uint32 nUnpacked);
+
+	/**
+	 * Buffer for the packed data, kept between calls to avoid
+	 * reallocating it for every resource or robot frame.
+	 */
+	Common::Array<byte> _packedData;
 };
 #endif
 
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -56,10 +57,11 @@ void WorklistManager::push(reg_t reg) {
 
 	debugC(kDebugLevelGC, "[GC] Adding %04x:%04x", PRINT_REG(reg));
 
-	if (_map.contains(reg))
+	bool &known = _map[reg];
+	if (known)
 		return; // already dealt with it
 
-	_map.setVal(reg, true);
+	known = true;
 	_worklist.push_back(reg);
 }
 
@@ -181,6 +183,8 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -213,7 +217,10 @@ void run_gc(EngineState *s) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
+					if (mobj->getType() == SEG_TYPE_CLONES)
+						segMan->getSendCache().invalidate(); // The clone's address may get reused
 					mobj->freeAtAddress(segMan, addr);
+					++freed;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -224,8 +231,22 @@ void run_gc(EngineState *s) {
 		}
 	}
 
+	const uint32 live = activeRefs->size();
 	delete activeRefs;
 
+	segMan->resetAllocationsSinceGC();
+
+	const uint32 duration = g_system->getMillis() - startTime;
+	GCStatistics &stats = segMan->getGCStatistics();
+	++stats.runs;
+	stats.lastMillis = duration;
+	stats.maxMillis = MAX(stats.maxMillis, duration);
+	stats.totalMillis += duration;
+	stats.lastLive = live;
+	stats.lastFreed = freed;
+	stats.totalFreed += freed;
+	debugC(kDebugLevelGC, "[GC] Freed %d entries, %d live references, took %d ms", freed, live, duration);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +256,13 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void run_gc_if_needed(EngineState *s) {
+	if (!s->_segMan->getAllocationsSinceGC()) {
+		++s->_segMan->getGCStatistics().skipped;
+		return;
+	}
+
+	run_gc(s);
+}
+
 } // End of namespace Sci
@@ -55,6 +55,15 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs garbage collection on the current system state, unless no collectable
+ * entries have been allocated and no scripts have been unloaded since the
+ * last collection. Any garbage left over in that case was already allocated
+ * back then, so skipping the collection cannot make memory usage grow.
+ * @param s The state in which we should gc
+ */
+void run_gc_if_needed(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
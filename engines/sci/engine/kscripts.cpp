@@ -46,6 +46,23 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// Resources are loaded on demand, but scripts announce what they are
+	// going to use here, e.g. when setting up a new room. Remember these,
+	// so that they can be loaded while the engine is idle.
+	switch (restype) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeScript:
+	case kResourceTypeFont:
+	case kResourceTypeCursor:
+	case kResourceTypePalette:
+	case kResourceTypeSound:
+		g_sci->getResMan()->queuePrefetch(ResourceId(restype, resnr));
+		break;
+	default:
+		break;
+	}
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
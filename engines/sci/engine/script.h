@@ -102,6 +102,10 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	Common::Array<uint16> _instructionIndex; /**< 1-based index into _instructions for each buffer offset, 0 if not decoded yet */
+	Common::Array<PMachineInstruction> _instructions; /**< Instructions decoded so far */
+	PMachineInstruction _uncachedInstruction; /**< Used once _instructions can no longer be indexed */
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -120,6 +124,14 @@ public:
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
+	/**
+	 * Returns the decoded PMachine instruction at the given offset. Each
+	 * instruction is decoded the first time it gets executed and is then
+	 * served from a per-script cache. The returned reference is only valid
+	 * until the next call.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset);
+
 	int getScriptNumber() const { return _nr; }
 	SegmentId getLocalsSegment() const { return _localsSegment; }
 	reg_t *getLocalsBegin() { return _localsBlock ? _localsBlock->_locals.begin() : NULL; }
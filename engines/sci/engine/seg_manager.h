@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/serializer.h"
 #include "sci/engine/script.h"
+#include "sci/engine/selector.h"
 #include "sci/engine/vm.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/segment.h"
@@ -46,6 +47,18 @@ enum ScriptLoadType {
 
 class Script;
 
+/** Statistics about the garbage collections done so far */
+struct GCStatistics {
+	uint32 runs;        ///< Number of collections
+	uint32 skipped;     ///< Number of collections skipped by run_gc_if_needed()
+	uint32 lastMillis;  ///< Duration of the last collection
+	uint32 maxMillis;   ///< Duration of the longest collection
+	uint32 totalMillis; ///< Time spent in all collections
+	uint32 lastLive;    ///< Number of live references found by the last collection
+	uint32 lastFreed;   ///< Number of entries freed by the last collection
+	uint32 totalFreed;  ///< Number of entries freed by all collections
+};
+
 class SegManager : public Common::Serializable {
 	friend class Console;
 public:
@@ -456,11 +469,31 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/** Returns the selector lookup cache used by send operations. */
+	SendCache &getSendCache() { return _sendCache; }
+
+	/**
+	 * Returns the number of collectable entries allocated and scripts
+	 * unloaded since the last garbage collection.
+	 */
+	uint32 getAllocationsSinceGC() const { return _allocationsSinceGC; }
+	void resetAllocationsSinceGC() { _allocationsSinceGC = 0; }
+
+	/**
+	 * Returns the statistics about the garbage collections done since the
+	 * game was started.
+	 */
+	GCStatistics &getGCStatistics() { return _gcStatistics; }
+	void resetGCStatistics() { memset(&_gcStatistics, 0, sizeof(_gcStatistics)); }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
 	Common::HashMap<int, SegmentId> _scriptSegMap;
+	SendCache _sendCache;
+	uint32 _allocationsSinceGC;
+	GCStatistics _gcStatistics;
 
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
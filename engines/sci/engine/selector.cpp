@@ -292,7 +292,7 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	ExecStack *xstack;
 
 	// Now commit the actual function:
-	xstack = send_selector(s, object, object, stackframe, framesize, stackframe);
+	xstack = send_selector(s, object, object, stackframe, framesize, stackframe, make_reg32(0, 0));
 
 	xstack->sp += argc + 2;
 	xstack->fp += argc + 2;
@@ -345,4 +345,78 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 //	return _lookupSelector_function(segMan, obj, selectorId, fptr);
 }
 
+SendCache::SendCache() {
+	resetStats();
+}
+
+SelectorType SendCache::lookup(SegManager *segMan, reg32_t callSite, reg_t obj, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+	SiteKey key;
+	key.callSite = callSite;
+	key.selector = selectorId;
+	Site &site = _sites[key];
+
+	const Entry *entry = NULL;
+	for (uint i = 0; i < site.numEntries; ++i) {
+		if (site.entries[i].obj == obj) {
+			entry = &site.entries[i];
+			break;
+		}
+	}
+
+	if (entry) {
+		++_stats.hits;
+	} else {
+		++_stats.misses;
+
+		Entry newEntry;
+		ObjVarRef var;
+		newEntry.obj = obj;
+		newEntry.varIndex = 0;
+		newEntry.func = NULL_REG;
+		newEntry.type = lookupSelector(segMan, obj, selectorId, &var, &newEntry.func);
+		if (newEntry.type == kSelectorNone)
+			return kSelectorNone;
+		if (newEntry.type == kSelectorVariable)
+			newEntry.varIndex = var.varindex;
+
+		uint index;
+		if (site.numEntries < kEntriesPerSite) {
+			index = site.numEntries++;
+		} else {
+			// Polymorphic call site, replace the receivers round-robin
+			index = site.nextReplacement;
+			site.nextReplacement = (site.nextReplacement + 1) % kEntriesPerSite;
+			++_stats.replacements;
+		}
+		site.entries[index] = newEntry;
+		entry = &site.entries[index];
+	}
+
+	if (entry->type == kSelectorVariable) {
+		if (varp) {
+			varp->obj = obj;
+			varp->varindex = entry->varIndex;
+		}
+	} else if (fptr) {
+		*fptr = entry->func;
+	}
+
+	return entry->type;
+}
+
+void SendCache::invalidate() {
+	if (_sites.empty())
+		return;
+
+	_sites.clear();
+	++_stats.invalidations;
+}
+
+void SendCache::resetStats() {
+	_stats.hits = 0;
+	_stats.misses = 0;
+	_stats.replacements = 0;
+	_stats.invalidations = 0;
+}
+
 } // End of namespace Sci
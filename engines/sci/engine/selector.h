@@ -24,6 +24,7 @@
 #define SCI_ENGINE_SELECTOR_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 
 #include "sci/engine/vm_types.h"	// for reg_t
 #include "sci/engine/vm.h"
@@ -221,6 +222,80 @@ void writeSelector(SegManager *segMan, reg_t object, Selector selectorId, reg_t
 void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	int k_argc, StackPtr k_argp, int argc = 0, const reg_t *argv = 0);
 
+/**
+ * Inline cache for the selector lookups done by send operations. Each send
+ * call site remembers the result of lookupSelector() for the last few
+ * objects it has sent the selector to, so that repeated sends from the same
+ * code (e.g. doit methods called every cycle) do not walk the class chain
+ * again. Entries are keyed on the receiver address, so the cache must be
+ * invalidated whenever objects can disappear or move: when scripts are
+ * loaded or unloaded, segments are freed, or clones are collected.
+ */
+class SendCache {
+public:
+	enum {
+		kEntriesPerSite = 4 ///< Number of receivers remembered per call site
+	};
+
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 replacements; ///< Misses that replaced an entry at a full call site
+		uint32 invalidations;
+	};
+
+	SendCache();
+
+	/**
+	 * Looks up a selector like lookupSelector(), consulting the cache of the
+	 * given call site first.
+	 */
+	SelectorType lookup(SegManager *segMan, reg32_t callSite, reg_t obj, Selector selectorId, ObjVarRef *varp, reg_t *fptr);
+
+	/** Drops all cached lookups. */
+	void invalidate();
+
+	uint getNumSites() const { return _sites.size(); }
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	struct Entry {
+		reg_t obj;
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+	};
+
+	struct Site {
+		Site() : numEntries(0), nextReplacement(0) {}
+
+		Entry entries[kEntriesPerSite];
+		byte numEntries;
+		byte nextReplacement;
+	};
+
+	struct SiteKey {
+		reg32_t callSite;
+		Selector selector;
+
+		bool operator==(const SiteKey &other) const {
+			return callSite == other.callSite && selector == other.selector;
+		}
+	};
+
+	struct SiteKey_Hash {
+		uint operator()(const SiteKey &x) const {
+			return (x.callSite.getSegment() << 3) ^ x.callSite.getOffset() ^ (x.selector << 16);
+		}
+	};
+
+	typedef Common::HashMap<SiteKey, Site, SiteKey_Hash> SiteMap;
+
+	SiteMap _sites;
+	Stats _stats;
+};
+
 #ifdef ENABLE_SCI32
 /**
  * SCI32 set kInfoFlagViewVisible in the -info- selector if a certain
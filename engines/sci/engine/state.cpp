@@ -116,6 +116,8 @@ void EngineState::reset(bool isRestoring) {
 	_cursorWorkaroundActive = false;
 
 	scriptStepCounter = 0;
+	memset(scriptOpcodeCounters, 0, sizeof(scriptOpcodeCounters));
+	scriptMillis = 0;
 	scriptGCInterval = GC_INTERVAL;
 
 	_videoState.reset();
@@ -184,6 +184,8 @@ public:
 	int16 gameIsRestarting; // is set when restarting (=1) or restoring the game (=2)
 
 	int scriptStepCounter; // Counts the number of steps executed
+	uint32 scriptOpcodeCounters[128]; // Counts the number of steps executed per opcode
+	uint32 scriptMillis; // Time spent executing scripts outside of kernel calls, in milliseconds
 	int scriptGCInterval; // Number of steps in between gcs
 
 	uint16 currentRoomNumber() const;
@@ -347,10 +347,12 @@ ExecStack *execute_method(EngineState *s, uint16 script, uint16 pubfunct,
  * 						[selector_number][argument_counter] and then
  * 						"argument_counter" word entries with the
  * 						parameter values.
+ * @param[in] callSite	Address following the send instruction, used to
+ * 						key the selector lookup cache
  * @return				A pointer to the new execution stack TOS entry
  */
 ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj,
-	StackPtr sp, int framesize, StackPtr argp);
+	StackPtr sp, int framesize, StackPtr argp, reg32_t callSite);
 
 
 /**
@@ -408,6 +410,17 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
  */
 int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]);
 
+/**
+ * A PMachine instruction as decoded by readPMachineInstruction(), cached per
+ * script so that run_vm() does not have to re-parse the opcode format each
+ * time the instruction is executed.
+ */
+struct PMachineInstruction {
+	int16 opparams[4];	///< parameters of the instruction
+	uint16 size;		///< length of the instruction in bytes
+	byte extOpcode;		///< "extended" opcode of the instruction
+};
+
 /**
  * Finds the script-absolute offset of a relative object offset.
  *
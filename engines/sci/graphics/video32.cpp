@@ -122,10 +122,15 @@ VideoPlayer::EventFlags VideoPlayer::playUntilEvent(const EventFlags flags, cons
 	// activating a video stop flag
 	_eventMan->flushEvents();
 
+	// Spend the time until the next frame is due on decoding the following
+	// ones, so that expensive frames do not make the playback stutter
+	_decoder->setDecodeAhead(kDecodeAheadFrames);
 	_decoder->start();
 
 	EventFlags stopFlag = kEventFlagNone;
 	for (;;) {
+		while (_decoder->decodeAhead()) {}
+
 		g_sci->sleep(MIN(_decoder->getTimeToNextFrame(), maxSleepMs));
 
 		const Graphics::Surface *nextFrame = nullptr;
@@ -160,6 +165,10 @@ VideoPlayer::EventFlags VideoPlayer::playUntilEvent(const EventFlags flags, cons
 		g_sci->_gfxFrameout->updateScreen();
 	}
 
+	const Video::VideoDecoder::DecodeAheadStats &stats = _decoder->getDecodeAheadStats();
+	debugC(kDebugLevelVideo, "Decode-ahead: %u frames queued, %u frames from queue, %u decoded on demand, max queue depth %u",
+	       stats.framesDecodedAhead, stats.framesFromQueue, stats.framesOnDemand, stats.maxQueueDepth);
+
 	return stopFlag;
 }
 
@@ -79,6 +79,14 @@ public:
 	virtual ~VideoPlayer() {}
 
 protected:
+	enum {
+		/**
+		 * The maximum number of frames to decode ahead of time during
+		 * playback.
+		 */
+		kDecodeAheadFrames = 4
+	};
+
 	EventManager *_eventMan;
 
 	/**
@@ -201,6 +201,8 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_compression = kCompNone;
+	_prefetched = false;
 }
 
 Resource::~Resource() {
@@ -214,6 +216,7 @@ void Resource::unalloc() {
 	delete[] _data;
 	_data = nullptr;
 	_status = kResStatusNoMalloc;
+	_prefetched = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -954,10 +957,16 @@ ResourceManager::ResourceManager(const bool detectionMode) :
 	_detectionMode(detectionMode) {}
 
 void ResourceManager::init() {
+#ifdef REDUCE_MEMORY_USAGE
 	_maxMemoryLRU = 256 * 1024; // 256KiB
+#else
+	_maxMemoryLRU = 1024 * 1024; // 1MiB
+#endif
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
+	resetCacheStats();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1009,7 +1018,11 @@ void ResourceManager::init() {
 	// cache, leading to constant decompression of picture resources
 	// and making the renderer very slow.
 	if (getSciVersion() >= SCI_VERSION_2) {
+#ifdef REDUCE_MEMORY_USAGE
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
+#else
+		_maxMemoryLRU = 16384 * 1024; // 16MiB
+#endif
 	}
 
 	switch (_viewType) {
@@ -1058,7 +1071,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	_LRU.erase(res->_lruPosition);
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1069,6 +1082,7 @@ void ResourceManager::addToLRU(Resource *res) {
 		return;
 	}
 	_LRU.push_front(res);
+	res->_lruPosition = _LRU.begin();
 	_memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1095,12 +1109,32 @@ void ResourceManager::printLRU() {
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
+Common::List<Resource *>::iterator ResourceManager::findEvictionCandidate() {
+	// Among the least recently used resources, prefer the ones that can be
+	// reloaded without decompressing them. Otherwise, fall back to the
+	// least recently used one.
+	const int kEvictionWindow = 8;
+
+	Common::List<Resource *>::iterator candidate = --_LRU.end();
+	Common::List<Resource *>::iterator it = candidate;
+	for (int i = 0; i < kEvictionWindow; ++i) {
+		if ((*it)->_compression == kCompNone)
+			return it;
+		if (it == _LRU.begin())
+			break;
+		--it;
+	}
+
+	return candidate;
+}
+
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
 		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		Resource *goner = *findEvictionCandidate();
 		removeFromLRU(goner);
 		goner->unalloc();
+		++_cacheStats.evictions;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
@@ -1126,15 +1160,24 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		// The resource is removed from its current position
-		// in the LRU list because it has been requested
-		// again. Below, it will either be locked, or it
-		// will be added back to the LRU list at the 'most
-		// recent' position.
-		removeFromLRU(retval);
+		++_cacheStats.misses;
+	} else {
+		++_cacheStats.hits;
+		if (retval->_prefetched) {
+			retval->_prefetched = false;
+			++_cacheStats.prefetchHits;
+		}
+
+		if (retval->_status == kResStatusEnqueued)
+			// The resource is removed from its current position
+			// in the LRU list because it has been requested
+			// again. Below, it will either be locked, or it
+			// will be added back to the LRU list at the 'most
+			// recent' position.
+			removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -1178,6 +1221,53 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+void ResourceManager::queuePrefetch(ResourceId id) {
+	// Don't let the queue grow if the engine never gets idle
+	const int kMaxPrefetchQueueSize = 32;
+
+	if (_prefetchQueue.size() < kMaxPrefetchQueueSize)
+		_prefetchQueue.push(id);
+}
+
+bool ResourceManager::prefetchNext() {
+	while (!_prefetchQueue.empty()) {
+		Resource *res = testResource(_prefetchQueue.pop());
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		// Don't push resources out of the cache for one that may not be used.
+		// The size of resources from map files is only known once they have
+		// been loaded, so check again afterwards.
+		if (_memoryLRU + (int)res->_size > _maxMemoryLRU)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		if (_memoryLRU + (int)res->_size > _maxMemoryLRU) {
+			res->unalloc();
+			continue;
+		}
+
+		res->_prefetched = true;
+		addToLRU(res);
+		++_cacheStats.prefetches;
+		return true;
+	}
+
+	return false;
+}
+
+void ResourceManager::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
+void ResourceManager::setMaxMemory(int maxMemory) {
+	_maxMemoryLRU = maxMemory;
+	freeOldResources();
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
@@ -2211,6 +2301,7 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	errorNum = readResourceInfo(volVersion, file, szPacked, compression);
 	if (errorNum)
 		return errorNum;
+	_compression = compression;
 
 	// getting a decompressor
 	Decompressor *dec = NULL;
@@ -26,6 +26,7 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/queue.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/decompressor.h"
@@ -293,6 +294,9 @@ protected:
 	uint16 _lockers; /**< Number of places where this resource was locked */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
+	Common::List<Resource *>::iterator _lruPosition; /**< Position in the LRU list, if enqueued */
+	ResourceCompression _compression; /**< Compression method of the resource data */
+	bool _prefetched; /**< Loaded by prefetching and not requested since */
 
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
@@ -375,6 +379,42 @@ public:
 	 */
 	Resource *testResource(ResourceId id);
 
+	/**
+	 * Announces that a resource is going to be needed soon, so that it can
+	 * be loaded in advance by prefetchNext().
+	 * @param id	Id of the resource to prefetch
+	 */
+	void queuePrefetch(ResourceId id);
+
+	/**
+	 * Loads the next announced resource which is not in memory yet. Called
+	 * while the engine is idle. Resources are only prefetched as long as
+	 * they fit into the cache without evicting others.
+	 * @return		true if a resource was loaded, false if there was nothing
+	 *				to do
+	 */
+	bool prefetchNext();
+
+	struct CacheStats {
+		uint32 hits;			///< Requests for resources that were in memory
+		uint32 misses;			///< Requests that had to load the resource
+		uint32 evictions;		///< Resources freed to stay within the budget
+		uint32 prefetches;		///< Resources loaded by prefetchNext()
+		uint32 prefetchHits;	///< Prefetched resources that got requested later
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
+	/**
+	 * Sets the number of bytes that unlocked resources may occupy before the
+	 * least valuable ones get freed.
+	 */
+	void setMaxMemory(int maxMemory);
+	int getMaxMemory() const { return _maxMemoryLRU; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+
 	/**
 	 * Returns a list of all resources of the specified type.
 	 * @param type		The resource type to look for
@@ -475,6 +515,8 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Common::Queue<ResourceId> _prefetchQueue; ///< Resources announced by the scripts
+	CacheStats _cacheStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -535,6 +577,7 @@ protected:
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
 	void freeOldResources();
+	Common::List<Resource *>::iterator findEvictionCandidate();
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
 	Resource *updateResource(ResourceId resId, ResourceSource *src, uint32 size, const Common::String &sourceMapLocation = Common::String("(no map location)"));
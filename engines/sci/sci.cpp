@@ -262,6 +262,10 @@ Common::Error SciEngine::run() {
 	_resMan->addAppropriateSources();
 	_resMan->init();
 
+	// Allow users with plenty of memory to keep more resources in memory
+	if (ConfMan.hasKey("resource_cache_size"))
+		_resMan->setMaxMemory(ConfMan.getInt("resource_cache_size") * 1024);
+
 	// TODO: Add error handling. Check return values of addAppropriateSources
 	// and init. We first have to *add* sensible return values, though ;).
 /*
@@ -665,7 +669,7 @@ void SciEngine::initStackBaseWithSelector(Selector selector) {
 	_gamestate->stack_base[1] = NULL_REG;
 
 	// Register the first element on the execution stack
-	if (!send_selector(_gamestate, _gameObjectAddress, _gameObjectAddress, _gamestate->stack_base, 2, _gamestate->stack_base)) {
+	if (!send_selector(_gamestate, _gameObjectAddress, _gameObjectAddress, _gamestate->stack_base, 2, _gamestate->stack_base, make_reg32(0, 0))) {
 		printObject(_gameObjectAddress);
 		error("initStackBaseWithSelector: error while registering the first selector in the call stack");
 	}
@@ -848,6 +852,9 @@ void SciEngine::sleep(uint32 msecs) {
 		return;
 	}
 
+	// Idle time needed before a resource is prefetched, in ms
+	const uint32 kPrefetchMinIdleTime = 30;
+
 	uint32 time;
 	const uint32 wakeUpTime = g_system->getMillis() + msecs;
 
@@ -864,7 +871,11 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		time = g_system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			g_system->delayMillis(10);
+			// Use the idle time to load resources the scripts announced.
+			// Loading one can take a while, e.g. when an SCI32 pic has to be
+			// decompressed, so only do so when there is plenty of time left.
+			if (time + kPrefetchMinIdleTime > wakeUpTime || !_resMan->prefetchNext())
+				g_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				g_system->delayMillis(wakeUpTime - time);
@@ -47,6 +47,10 @@ MoviePlayer::MoviePlayer(ScummEngine_v90he *vm, Audio::Mixer *mixer) : _vm(vm) {
 #endif
 		_video = new Video::SmackerDecoder();
 
+	// Decode the next frame while the engine idles, instead of when the
+	// frame is to be shown
+	_video->setDecodeAhead(kDecodeAheadFrames);
+
 	_flags = 0;
 	_wizResNum = 0;
 }
@@ -123,18 +127,20 @@ void MoviePlayer::copyFrameToBuffer(byte *dst, int dstType, uint x, uint y, uint
 		} else {
 			dst += y * pitch + x * 2;
 			do {
-				for (uint i = 0; i < w; i++) {
-					uint16 color = *((const uint16 *)src + i);
-					switch (dstType) {
-					case kDstScreen:
-						WRITE_UINT16(dst + i * 2, color);
-						break;
-					case kDstResource:
-						WRITE_LE_UINT16(dst + i * 2, color);
-						break;
-					default:
-						error("copyFrameToBuffer: Unknown dstType %d", dstType);
-					}
+				switch (dstType) {
+				case kDstScreen:
+					memcpy(dst, src, w * 2);
+					break;
+				case kDstResource:
+#ifdef SCUMM_LITTLE_ENDIAN
+					memcpy(dst, src, w * 2);
+#else
+					for (uint i = 0; i < w; i++)
+						WRITE_LE_UINT16(dst + i * 2, *((const uint16 *)src + i));
+#endif
+					break;
+				default:
+					error("copyFrameToBuffer: Unknown dstType %d", dstType);
 				}
 				dst += pitch;
 				src += surface->pitch;
@@ -178,6 +184,13 @@ void MoviePlayer::handleNextFrame() {
 		_video->close();
 }
 
+bool MoviePlayer::decodeAhead() {
+	if (!_video->isVideoLoaded())
+		return false;
+
+	return _video->decodeAhead();
+}
+
 void MoviePlayer::close() {
 	_video->close();
 }
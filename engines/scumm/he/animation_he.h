@@ -49,6 +49,7 @@ public:
 
 	void copyFrameToBuffer(byte *dst, int dstType, uint x, uint y, uint pitch);
 	void handleNextFrame();
+	bool decodeAhead();
 
 	void close();
 	int getWidth() const;
@@ -57,6 +58,14 @@ public:
 	int getCurFrame() const;
 
 private:
+	enum {
+		/**
+		 * The maximum number of frames to decode ahead of time, while the
+		 * engine waits for its next tick.
+		 */
+		kDecodeAheadFrames = 2
+	};
+
 	ScummEngine_v90he *_vm;
 
 	Video::VideoDecoder *_video;
@@ -485,6 +485,7 @@ protected:
 
 	virtual void scummLoop(int delta);
 	virtual void scummLoop_handleDrawing();
+	virtual bool handleIdleTime();
 	virtual void runBootscript();
 
 	virtual void processInput();
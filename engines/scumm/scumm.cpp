@@ -2172,7 +2172,8 @@ void ScummEngine::waitForTimer(int msec_delay) {
 		_system->updateScreen();
 		if (_system->getMillis() >= start_time + msec_delay)
 			break;
-		_system->delayMillis(10);
+		if (!handleIdleTime())
+			_system->delayMillis(10);
 	}
 }
 
@@ -2349,6 +2350,10 @@ load_game:
 }
 
 #ifdef ENABLE_HE
+bool ScummEngine_v90he::handleIdleTime() {
+	return _moviePlay->decodeAhead();
+}
+
 void ScummEngine_v90he::scummLoop(int delta) {
 	_moviePlay->handleNextFrame();
 	if (_game.heversion >= 98) {
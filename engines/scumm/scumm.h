@@ -474,6 +474,12 @@ protected:
 	virtual void parseEvent(Common::Event event);
 
 	void waitForTimer(int msec_delay);
+
+	/**
+	 * Called by waitForTimer() while waiting, to do work ahead of time.
+	 * @return true if any work was done
+	 */
+	virtual bool handleIdleTime() { return false; }
 	virtual void processInput();
 	virtual void processKeyboard(Common::KeyState lastKeyHit);
 	virtual void clearClickedStatus();
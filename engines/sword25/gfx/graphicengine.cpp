@@ -275,30 +275,28 @@ Resource *GraphicEngine::loadResource(const Common::String &filename) {
 		assert(pPackage);
 
 		// Loading data
-		byte *pFileData;
-		uint fileSize;
-		pFileData = pPackage->getFile(filename, &fileSize);
-		if (!pFileData) {
+		Common::SeekableReadStream *in = pPackage->getDataStream(filename);
+		if (!in) {
 			error("File \"%s\" could not be loaded.", filename.c_str());
 			return 0;
 		}
 
 		bool result = false;
-		VectorImage *pImage = new VectorImage(pFileData, fileSize, result, filename);
+		VectorImage *pImage = new VectorImage(in->getData(), in->size(), result, filename);
 		if (!result) {
 			delete pImage;
-			delete[] pFileData;
+			delete in;
 			return 0;
 		}
 
 		BitmapResource *pResource = new BitmapResource(filename, pImage);
 		if (!pResource->isValid()) {
 			delete pResource;
-			delete[] pFileData;
+			delete in;
 			return 0;
 		}
 
-		delete[] pFileData;
+		delete in;
 		return pResource;
 	}
 
@@ -40,19 +40,19 @@ namespace Sword25 {
 
 bool ImgLoader::decodePNGImage(const byte *fileDataPtr, uint fileSize, Graphics::Surface *dest) {
 	assert(dest);
-	Common::MemoryReadStream *fileStr = new Common::MemoryReadStream(fileDataPtr, fileSize, DisposeAfterUse::NO);
 
-	::Image::PNGDecoder png;
-	if (!png.loadStream(*fileStr)) // the fileStr pointer, and thus pFileData will be deleted after this is done
+	// The image size is stored in the IHDR chunk, which directly follows
+	// the signature. Knowing it, the image can be decoded straight into dest.
+	if (fileSize < 24 || READ_BE_UINT32(fileDataPtr + 12) != MKTAG('I', 'H', 'D', 'R'))
 		error("Error while reading PNG image");
+	dest->create(READ_BE_UINT32(fileDataPtr + 16), READ_BE_UINT32(fileDataPtr + 20), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
 
-	const Graphics::Surface *sourceSurface = png.getSurface();
-	Graphics::Surface *pngSurface = sourceSurface->convertTo(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), png.getPalette());
+	Common::MemoryReadStream *fileStr = new Common::MemoryReadStream(fileDataPtr, fileSize, DisposeAfterUse::NO);
 
-	dest->copyFrom(*pngSurface);
+	::Image::PNGDecoder png;
+	if (!png.loadStreamInto(*fileStr, *dest)) // the fileStr pointer, and thus pFileData will be deleted after this is done
+		error("Error while reading PNG image");
 
-	pngSurface->free();
-	delete pngSurface;
 	delete fileStr;
 
 	// Signal success
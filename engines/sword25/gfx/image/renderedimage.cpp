@@ -109,15 +109,18 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
 	// Load file
-	byte *pFileData;
-	uint fileSize;
+	const byte *pFileData = 0;
+	uint fileSize = 0;
+	byte *thumbnailData = 0;
+	Common::SeekableReadStream *in = 0;
 
 	bool isPNG = true;
 
 	if (filename.hasPrefix("/saves")) {
-		pFileData = readSavegameThumbnail(filename, fileSize, isPNG);
-	} else {
-		pFileData = pPackage->getFile(filename, &fileSize);
+		pFileData = thumbnailData = readSavegameThumbnail(filename, fileSize, isPNG);
+	} else if ((in = pPackage->getDataStream(filename))) {
+		pFileData = in->getData();
+		fileSize = in->size();
 	}
 
 	if (!pFileData) {
@@ -133,12 +136,14 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 
 	if (!result) {
 		error("Could not decode image.");
-		delete[] pFileData;
+		delete[] thumbnailData;
+		delete in;
 		return;
 	}
 
 	// Cleanup FileData
-	delete[] pFileData;
+	delete[] thumbnailData;
+	delete in;
 
 	_doCleanup = true;
 
@@ -227,7 +232,51 @@ uint RenderedImage::getPixel(int x, int y) {
 // -----------------------------------------------------------------------------
 
 bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, RectangleList *updateRects) {
-	_surface.blit(*_backSurface, posX, posY, (((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0)), pPartRect, color, width, height);
+	int newFlipping = (((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0));
+
+	if (!updateRects) {
+		_surface.blit(*_backSurface, posX, posY, newFlipping, pPartRect, color, width, height);
+		return true;
+	}
+
+	Common::Rect partRect = pPartRect ? *pPartRect : Common::Rect(_surface.w, _surface.h);
+	if (width == -1)
+		width = partRect.width();
+	if (height == -1)
+		height = partRect.height();
+	const Common::Rect dstRect(posX, posY, posX + width, posY + height);
+
+	// Only draw the parts of the image inside the update rects. The rest of
+	// the back buffer is not copied to the screen anyway.
+	Graphics::TransparentSurface *scaled = nullptr;
+	for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+		if (!dstRect.intersects(*it))
+			continue;
+
+		if (width == partRect.width() && height == partRect.height()) {
+			_surface.blitClip(*_backSurface, *it, posX, posY, newFlipping, &partRect, color);
+			continue;
+		}
+
+		// Scale only once instead of for every update rect
+		if (!scaled) {
+			Graphics::TransparentSurface part(_surface, false);
+			int xOffset = (newFlipping & Graphics::FLIP_H) ? _surface.w - partRect.right : partRect.left;
+			int yOffset = (newFlipping & Graphics::FLIP_V) ? _surface.h - partRect.bottom : partRect.top;
+			part.setPixels(_surface.getBasePtr(xOffset, yOffset));
+			part.w = partRect.width();
+			part.h = partRect.height();
+
+			scaled = part.scale(width, height);
+			scaled->setAlphaMode(_surface.getAlphaMode());
+		}
+		scaled->blitClip(*_backSurface, *it, posX, posY, newFlipping, nullptr, color);
+	}
+
+	if (scaled) {
+		scaled->free();
+		delete scaled;
+	}
 
 	return true;
 }
@@ -42,22 +42,20 @@ SWImage::SWImage(const Common::String &filename, bool &result) : _image() {
 	assert(pPackage);
 
 	// Load file
-	byte *pFileData;
-	uint fileSize;
-	pFileData = pPackage->getFile(filename, &fileSize);
-	if (!pFileData) {
+	Common::SeekableReadStream *in = pPackage->getDataStream(filename);
+	if (!in) {
 		error("File \"%s\" could not be loaded.", filename.c_str());
 		return;
 	}
 
 	// Uncompress the image
-	if (!ImgLoader::decodePNGImage(pFileData, fileSize, &_image)) {
+	if (!ImgLoader::decodePNGImage(in->getData(), in->size(), &_image)) {
 		error("Could not decode image.");
 		return;
 	}
 
 	// Cleanup FileData
-	delete[] pFileData;
+	delete in;
 
 	result = true;
 	return;
@@ -135,16 +135,19 @@ bool RenderObject::render(RectangleList *updateRects, const Common::Array<int> &
 		return true;
 
 	// Objekt zeichnen.
-	bool needRender = false;
+	RectangleList visibleRects;
+	const int absoluteZ = getAbsoluteZ();
 	int index = 0;
 
-	// Only draw if the bounding box intersects any update rectangle and
-	// the object is in front of the minimum Z value.
-	for (RectangleList::iterator rectIt = updateRects->begin(); !needRender && rectIt != updateRects->end(); ++rectIt, ++index)
-		needRender = (_bbox.contains(*rectIt) || _bbox.intersects(*rectIt)) && getAbsoluteZ() >= updateRectsMinZ[index];
+	// Only draw into the update rectangles which the bounding box intersects
+	// and in which the object is in front of the minimum Z value.
+	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt, ++index) {
+		if ((_bbox.contains(*rectIt) || _bbox.intersects(*rectIt)) && absoluteZ >= updateRectsMinZ[index])
+			visibleRects.push_back(*rectIt);
+	}
 
-	if (needRender)
-		doRender(updateRects);
+	if (!visibleRects.empty())
+		doRender(&visibleRects);
 
 	// Draw all children
 	RENDEROBJECT_ITER it = _children.begin();
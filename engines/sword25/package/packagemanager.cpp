@@ -31,6 +31,7 @@
 
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/str-array.h"
 #include "common/system.h"
@@ -65,6 +66,8 @@ PackageManager::PackageManager(Kernel *pKernel) : Service(pKernel),
 }
 
 PackageManager::~PackageManager() {
+	_memberIndex.clear();
+
 	// Free the package list
 	Common::List<ArchiveEntry *>::iterator i;
 	for (i = _archiveList.begin(); i != _archiveList.end(); ++i)
@@ -92,10 +95,16 @@ Common::String PackageManager::ensureSpeechLang(const Common::String &fileName)
 }
 
 /**
- * Scans through the archive list for a specified file
+ * Scans through the archive list for a specified file, relative to the
+ * current directory
  */
 Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &fileName) {
-	Common::String fileName2 = ensureSpeechLang(fileName);
+	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator cached = _memberIndex.find(fileName);
+	if (cached != _memberIndex.end())
+		return cached->_value;
+
+	Common::ArchiveMemberPtr member;
+	Common::String fileName2 = ensureSpeechLang(normalizePath(fileName, _currentDirectory));
 	// Loop through checking each archive
 	Common::List<ArchiveEntry *>::iterator i;
 	for (i = _archiveList.begin(); i != _archiveList.end(); ++i) {
@@ -111,17 +120,21 @@ Common::ArchiveMemberPtr PackageManager::getArchiveMember(const Common::String &
 		Common::String resPath(&fileName2.c_str()[(*i)->_mountPath.size()]);
 
 		if (archiveFolder->hasFile(resPath)) {
-			return archiveFolder->getMember(resPath);
+			member = archiveFolder->getMember(resPath);
+			break;
 		}
 	}
 
-	return Common::ArchiveMemberPtr();
+	_memberIndex[fileName] = member;
+	return member;
 }
 
 bool PackageManager::loadPackage(const Common::String &fileName, const Common::String &mountPosition) {
 	debug(3, "loadPackage(%s, %s)", fileName.c_str(), mountPosition.c_str());
 
-	Common::Archive *zipFile = Common::makeZipArchive(fileName);
+	// Packages stay mounted until the package manager is destroyed, so the
+	// streams of stored members can read directly from mapped packages.
+	Common::Archive *zipFile = Common::makeZipArchive(fileName, true);
 	if (zipFile == NULL) {
 		error("Unable to mount file \"%s\" to \"%s\"", fileName.c_str(), mountPosition.c_str());
 		return false;
@@ -135,6 +148,7 @@ bool PackageManager::loadPackage(const Common::String &fileName, const Common::S
 			debug(3, "%s", (*it)->getName().c_str());
 
 		_archiveList.push_front(new ArchiveEntry(zipFile, mountPosition));
+		_memberIndex.clear();
 
 		return true;
 	}
@@ -154,6 +168,7 @@ bool PackageManager::loadDirectoryAsPackage(const Common::String &directoryName,
 		debug(0, "Capacity %d", files.size());
 
 		_archiveList.push_front(new ArchiveEntry(folderArchive, mountPosition));
+		_memberIndex.clear();
 
 		return true;
 	}
@@ -183,32 +198,24 @@ byte *PackageManager::getFile(const Common::String &fileName, uint *fileSizePtr)
 		return buffer;
 	}
 
-	Common::ArchiveMemberPtr fileNode = getArchiveMember(normalizePath(fileName, _currentDirectory));
-	if (!fileNode)
-		return 0;
-	if (!(in = fileNode->createReadStream()))
+	if (!(in = getDataStream(fileName)))
 		return 0;
 
 	// If the filesize is desired, then output the size
 	if (fileSizePtr)
 		*fileSizePtr = in->size();
 
-	// Read the file
+	// Copy the file
 	byte *buffer = new byte[in->size()];
-	int bytesRead = in->read(buffer, in->size());
+	memcpy(buffer, in->getData(), in->size());
 	delete in;
 
-	if (!bytesRead) {
-		delete[] buffer;
-		return NULL;
-	}
-
 	return buffer;
 }
 
 Common::SeekableReadStream *PackageManager::getStream(const Common::String &fileName) {
 	Common::SeekableReadStream *in;
-	Common::ArchiveMemberPtr fileNode = getArchiveMember(normalizePath(fileName, _currentDirectory));
+	Common::ArchiveMemberPtr fileNode = getArchiveMember(fileName);
 	if (!fileNode)
 		return 0;
 	if (!(in = fileNode->createReadStream()))
@@ -217,9 +224,36 @@ Common::SeekableReadStream *PackageManager::getStream(const Common::String &file
 	return in;
 }
 
+Common::SeekableReadStream *PackageManager::getDataStream(const Common::String &fileName) {
+	Common::SeekableReadStream *in = getStream(fileName);
+	if (!in || in->getData())
+		return in;
+
+	// Only copy the file if its stream does not provide the data already
+	const uint32 size = in->size();
+	byte *buffer = (byte *)malloc(size);
+	if (!buffer && size)
+		error("[PackageManager::getDataStream] Cannot allocate memory");
+
+	const uint32 bytesRead = in->read(buffer, size);
+	delete in;
+
+	if (bytesRead != size) {
+		free(buffer);
+		return 0;
+	}
+
+	return new Common::MemoryReadStream(buffer, size, DisposeAfterUse::YES);
+}
+
 bool PackageManager::changeDirectory(const Common::String &directory) {
 	// Get the path elements for the file
-	_currentDirectory = normalizePath(directory, _currentDirectory);
+	Common::String newDirectory = normalizePath(directory, _currentDirectory);
+	if (newDirectory != _currentDirectory) {
+		_currentDirectory = newDirectory;
+		// The index is keyed by paths relative to the current directory
+		_memberIndex.clear();
+	}
 	return true;
 }
 
@@ -230,18 +264,19 @@ Common::String PackageManager::getAbsolutePath(const Common::String &fileName) {
 bool PackageManager::fileExists(const Common::String &fileName) {
 	// FIXME: The current Zip implementation doesn't support getting a folder entry, which is needed for detecting
 	// the English voice pack
-	Common::String fileName2 = ensureSpeechLang(fileName);
-	if (fileName2 == "/speech/en") {
+	if (fileName.hasPrefix("/speech/") && ensureSpeechLang(fileName) == "/speech/en") {
 		// To get around this, change to detecting one of the files in the folder
-		bool exists = getArchiveMember(normalizePath(fileName2 + "/APO0001.ogg", _currentDirectory));
+		bool exists = getArchiveMember("/speech/en/APO0001.ogg");
 		if (!exists && _useEnglishSpeech) {
 			_useEnglishSpeech = false;
+			// Speech files resolve differently now
+			_memberIndex.clear();
 			warning("English speech not found");
 		}
 		return exists;
 	}
 
-	Common::ArchiveMemberPtr fileNode = getArchiveMember(normalizePath(fileName2, _currentDirectory));
+	Common::ArchiveMemberPtr fileNode = getArchiveMember(fileName);
 	return fileNode;
 }
 
@@ -50,6 +50,9 @@
 #include "common/archive.h"
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/stream.h"
 #include "common/str.h"
 
 #include "sword25/kernel/common.h"
@@ -88,6 +91,16 @@ private:
 	Common::FSNode _rootFolder;
 	Common::List<ArchiveEntry *> _archiveList;
 
+	/**
+	 * The results of getArchiveMember(), including the files which were not
+	 * found. Lua scripts request the same few files over and over again, so
+	 * this saves walking the archive list every time.
+	 * The keys are the file names as requested, so that a hit does not need
+	 * to normalize them. The index hence needs to be cleared whenever the
+	 * current directory or the mounted archives change.
+	 */
+	Common::HashMap<Common::String, Common::ArchiveMemberPtr> _memberIndex;
+
 	bool _useEnglishSpeech;
 	Common::String ensureSpeechLang(const Common::String &fileName);
 
@@ -131,6 +144,15 @@ public:
 	 * @return              Pointer to the stream object
 	 */
 	Common::SeekableReadStream *getStream(const Common::String &fileName);
+
+	/**
+	 * Returns a stream from file file from the directory tree, whose contents are
+	 * accessible through getData(). Files stored uncompressed in a memory mapped
+	 * package are not copied, other files are read into memory.
+	 * @param FileName      The filename of the file to load
+	 * @return              Pointer to the stream object
+	 */
+	Common::SeekableReadStream *getDataStream(const Common::String &fileName);
 	/**
 	 * Downloads an XML file and prefixes it with an XML Version key, since the XML files don't contain it,
 	 * and it is required for ScummVM to correctly parse the XML.
@@ -141,8 +163,12 @@ public:
 	 */
 	char *getXmlFile(const Common::String &fileName, uint *pFileSize = NULL) {
 		const char *versionStr = "<?xml version=\"1.0\"?>";
-		uint fileSize;
-		char *data = (char *)getFile(fileName, &fileSize);
+		Common::SeekableReadStream *in = getDataStream(fileName);
+		if (!in)
+			return NULL;
+
+		const uint fileSize = in->size();
+		const byte *data = in->getData();
 		char *result = (char *)malloc(fileSize + strlen(versionStr) + 1);
 		if (!result)
 			error("[PackageManager::getXmlFile] Cannot allocate memory");
@@ -151,7 +177,7 @@ public:
 		Common::copy(data, data + fileSize, result + strlen(versionStr));
 		result[fileSize + strlen(versionStr)] = '\0';
 
-		delete[] data;
+		delete in;
 		if (pFileSize)
 			*pFileSize = fileSize + strlen(versionStr);
 
@@ -120,11 +120,10 @@ static int findDirectories(lua_State *L) {
 static int getFileAsString(lua_State *L) {
 	PackageManager *pPM = getPM();
 
-	uint fileSize;
-	char *fileData = (char *)pPM->getFile(luaL_checkstring(L, 1), &fileSize);
-	if (fileData) {
-		lua_pushlstring(L, fileData, fileSize);
-		delete[] fileData;
+	Common::SeekableReadStream *in = pPM->getDataStream(luaL_checkstring(L, 1));
+	if (in) {
+		lua_pushlstring(L, (const char *)in->getData(), in->size());
+		delete in;
 
 		return 1;
 	} else
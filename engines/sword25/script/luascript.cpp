@@ -142,9 +142,8 @@ bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 	assert(pPackage);
 
 	// File read
-	uint fileSize;
-	byte *fileData = pPackage->getFile(fileName, &fileSize);
-	if (!fileData) {
+	Common::SeekableReadStream *in = pPackage->getDataStream(fileName);
+	if (!in) {
 		error("Couldn't read \"%s\".", fileName.c_str());
 #ifdef DEBUG
 		assert(__startStackDepth == lua_gettop(_state));
@@ -153,9 +152,9 @@ bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 	}
 
 	// Run the file content
-	if (!executeBuffer(fileData, fileSize, "@" + pPackage->getAbsolutePath(fileName))) {
+	if (!executeBuffer(in->getData(), in->size(), "@" + pPackage->getAbsolutePath(fileName))) {
 		// Release file buffer
-		delete[] fileData;
+		delete in;
 #ifdef DEBUG
 		assert(__startStackDepth == lua_gettop(_state));
 #endif
@@ -163,7 +162,7 @@ bool LuaScriptEngine::executeFile(const Common::String &fileName) {
 	}
 
 	// Release file buffer
-	delete[] fileData;
+	delete in;
 
 #ifdef DEBUG
 	assert(__startStackDepth == lua_gettop(_state));
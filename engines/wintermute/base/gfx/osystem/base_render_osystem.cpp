@@ -34,6 +34,7 @@
 #include "engines/wintermute/math/math_util.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_sprite.h"
+#include "engines/wintermute/wintermute.h"
 #include "common/system.h"
 #include "graphics/transparent_surface.h"
 #include "common/queue.h"
@@ -68,12 +69,14 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::~BaseRenderOSystem() {
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	const Graphics::TransformCache::Stats &stats = _transformCache.getStats();
+	debugC(kWintermuteDebugGeneral, "Transform cache: %u hits, %u misses, %u evictions",
+	       stats.hits, stats.misses, stats.evictions);
+	const DecodedImageCache::Stats &imageStats = _imageCache.getStats();
+	debugC(kWintermuteDebugGeneral, "Decoded image cache: %u hits, %u misses, %u evictions",
+	       imageStats.hits, imageStats.misses, imageStats.evictions);
+
+	clearTickets();
 
 	delete _dirtyRect;
 
@@ -167,11 +170,16 @@ bool BaseRenderOSystem::flip() {
 		}
 
 		addDirtyRect(_renderRect);
+
+		_lastFrameStats = _frameStats;
+		_frameStats = FrameStats();
 		return true;
 	}
 	if (!_disableDirtyRects) {
 		drawTickets();
 	} else {
+		_frameStats.dirtyArea = _renderSurface->w * _renderSurface->h;
+
 		// Clear the scale-buffered tickets that wasn't reused.
 		RenderQueueIterator it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
@@ -203,6 +211,9 @@ bool BaseRenderOSystem::flip() {
 
 	g_system->updateScreen();
 
+	_lastFrameStats = _frameStats;
+	_frameStats = FrameStats();
+
 	return STATUS_OK;
 }
 
@@ -271,6 +282,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 
 	if (_disableDirtyRects) {
+		++_frameStats.tickets;
 		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
@@ -283,24 +295,14 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 		return;
 	}
 
+	++_frameStats.tickets;
+
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it;
+		if (findQueuedTicket(compare, it)) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
@@ -320,6 +322,8 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	_transformCache.invalidate(surf);
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
@@ -328,39 +332,130 @@ void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
 	}
 }
 
-void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
-	renderTicket->_wantsDraw = true;
+bool BaseRenderOSystem::findQueuedTicket(const RenderTicket &compare, RenderQueueIterator &found) const {
+	TicketIndex::const_iterator bucket = _ticketIndex.find(compare.hash());
+	if (bucket == _ticketIndex.end()) {
+		return false;
+	}
+
+	RenderQueueIterator next = _lastFrameIter;
+	++next;
+	bool isFound = false;
+	const Common::Array<RenderQueueIterator> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		// Tickets not drawn yet in this frame are the ones after _lastFrameIter
+		const RenderTicket *ticket = *tickets[i];
+		if (ticket->_wantsDraw || !ticket->_isValid || !(*ticket == compare)) {
+			continue;
+		}
+		if (tickets[i] == next) {
+			found = next;
+			return true;
+		}
+		if (!isFound) {
+			found = tickets[i];
+			isFound = true;
+		}
+	}
+	return isFound;
+}
+
+void BaseRenderOSystem::indexTicket(const RenderQueueIterator &ticket) {
+	_ticketIndex[(*ticket)->hash()].push_back(ticket);
+}
+
+void BaseRenderOSystem::unindexTicket(RenderTicket *ticket) {
+	TicketIndex::iterator bucket = _ticketIndex.find(ticket->hash());
+	if (bucket == _ticketIndex.end()) {
+		return;
+	}
+
+	Common::Array<RenderQueueIterator> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		if (*tickets[i] == ticket) {
+			tickets.remove_at(i);
+			break;
+		}
+	}
+	if (tickets.empty()) {
+		_ticketIndex.erase(bucket);
+	}
+}
 
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::deleteTicket(RenderQueueIterator ticket) {
+	RenderTicket *renderTicket = *ticket;
+	unindexTicket(renderTicket);
+	delete renderTicket;
+	return _renderQueue.erase(ticket);
+}
+
+void BaseRenderOSystem::clearTickets() {
+	RenderQueueIterator it = _renderQueue.begin();
+	while (it != _renderQueue.end()) {
+		RenderTicket *ticket = *it;
+		it = _renderQueue.erase(it);
+		delete ticket;
+	}
+	_ticketIndex.clear();
+	_lastFrameIter = _renderQueue.end();
+}
+
+void BaseRenderOSystem::insertTicket(RenderTicket *renderTicket) {
 	++_lastFrameIter;
 	// In-order
 	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
 		_lastFrameIter--;
 		_renderQueue.push_back(renderTicket);
 		++_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
 	} else {
 		// Before something
 		RenderQueueIterator pos = _lastFrameIter;
 		_renderQueue.insert(pos, renderTicket);
 		--_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
 	}
 }
 
+void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
+	renderTicket->_wantsDraw = true;
+
+	insertTicket(renderTicket);
+	if (renderTicket->_owner) {
+		indexTicket(_lastFrameIter);
+	}
+	addDirtyRect(renderTicket->_dstRect);
+}
+
 void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket) {
 	RenderTicket *renderTicket = *ticket;
 	assert(!renderTicket->_wantsDraw);
 	renderTicket->_wantsDraw = true;
+	++_frameStats.matched;
 
 	++_lastFrameIter;
 	// Not in the same order?
 	if (*_lastFrameIter != renderTicket) {
+		// Drawing it before the tickets it skipped only makes a difference
+		// where it overlaps them
+		bool overlaps = false;
+		for (RenderQueueIterator it = _lastFrameIter; it != ticket; ++it) {
+			if ((*it)->_dstRect.intersects(renderTicket->_dstRect)) {
+				overlaps = true;
+				break;
+			}
+		}
+
 		--_lastFrameIter;
 		// Remove the ticket from the list
 		assert(*_lastFrameIter != renderTicket);
+		unindexTicket(renderTicket);
 		_renderQueue.erase(ticket);
-		// Is not in order, so readd it as if it was a new ticket
-		drawFromTicket(renderTicket);
+		// Is not in order, so readd it at the current position
+		insertTicket(renderTicket);
+		indexTicket(_lastFrameIter);
+		if (overlaps) {
+			addDirtyRect(renderTicket->_dstRect);
+		}
+		++_frameStats.reordered;
 	}
 }
 
@@ -381,10 +476,8 @@ void BaseRenderOSystem::drawTickets() {
 	// we have a copy of their data, so their invalidness won't affect us.
 	while (it != _renderQueue.end()) {
 		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+			it = deleteTicket(it);
 		} else {
 			++it;
 		}
@@ -399,6 +492,8 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
+	_frameStats.dirtyArea = _dirtyRect->width() * _dirtyRect->height();
+
 	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
@@ -441,10 +536,8 @@ void BaseRenderOSystem::drawTickets() {
 	// Clean out the old tickets
 	while (it != _renderQueue.end()) {
 		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+			it = deleteTicket(it);
 		} else {
 			++it;
 		}
@@ -565,16 +658,10 @@ void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearTickets();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
-	_lastFrameIter = _renderQueue.end();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->h, _renderSurface->w), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
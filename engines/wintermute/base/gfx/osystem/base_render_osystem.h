@@ -33,7 +33,11 @@
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "common/list.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "graphics/transform_struct.h"
+#include "graphics/transform_cache.h"
+#include "engines/wintermute/base/gfx/osystem/decoded_image_cache.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
@@ -52,6 +56,8 @@ class RenderTicket;
  * they came before, on, or after the drawNum they had last frame. Everything else
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
+ * Changes in order between tickets which don't overlap don't change the result though,
+ * and thus don't need any redrawing.
  *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accomodate situations with large enough amounts of draw calls,
@@ -64,6 +70,20 @@ public:
 
 	typedef Common::List<RenderTicket *>::iterator RenderQueueIterator;
 
+	/** Statistics about the ticket matching of a single frame. */
+	struct FrameStats {
+		FrameStats() : tickets(0), matched(0), reordered(0), dirtyArea(0) {}
+
+		/** Number of draw calls. */
+		uint32 tickets;
+		/** Number of draw calls identical to one of the previous frame. */
+		uint32 matched;
+		/** Number of matched draw calls which changed their position in the draw order. */
+		uint32 reordered;
+		/** Number of pixels which had to be redrawn. */
+		uint32 dirtyArea;
+	};
+
 	Common::String getName() const;
 
 	bool initRenderer(int width, int height, bool windowed) override;
@@ -87,7 +107,8 @@ public:
 	void drawFromTicket(RenderTicket *renderTicket);
 	/**
 	 * Re-insert an existing ticket into the queue, adding a dirty rect
-	 * out-of-order from last draw from the ticket.
+	 * out-of-order from last draw from the ticket, if it overlaps any of
+	 * the tickets it skipped.
 	 * @param ticket iterator pointing to the ticket to be added.
 	 */
 	void drawFromQueuedTicket(const RenderQueueIterator &ticket);
@@ -112,7 +133,34 @@ public:
 	void endSaveLoad();
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
+	/**
+	 * Scaled and rotated surface areas, keyed by their owning BaseSurfaceOSystem.
+	 * Entries are dropped along with the tickets of a surface.
+	 */
+	Graphics::TransformCache &getTransformCache() { return _transformCache; }
+	/**
+	 * Decoded images of files no surface is using right now, so that they
+	 * survive scene changes.
+	 */
+	DecodedImageCache &getImageCache() { return _imageCache; }
+	/** Return the statistics of the last completed frame. */
+	const FrameStats &getFrameStats() const { return _lastFrameStats; }
 private:
+	typedef Common::HashMap<uint, Common::Array<RenderQueueIterator> > TicketIndex;
+
+	/**
+	 * Find a ticket of the last frame which was not drawn again yet and
+	 * equals the given one, preferring the one next in order.
+	 * @return true if such a ticket was found
+	 */
+	bool findQueuedTicket(const RenderTicket &compare, RenderQueueIterator &found) const;
+	void indexTicket(const RenderQueueIterator &ticket);
+	void unindexTicket(RenderTicket *ticket);
+	/** Remove a ticket from the queue and delete it, returning the next one. */
+	RenderQueueIterator deleteTicket(RenderQueueIterator ticket);
+	/** Insert a ticket into the queue at the current position. */
+	void insertTicket(RenderTicket *renderTicket);
+	void clearTickets();
 	/**
 	 * Mark a specified rect of the screen as dirty.
 	 * @param rect the region to be marked as dirty
@@ -128,6 +176,12 @@ private:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
 	Common::Rect *_dirtyRect;
 	Common::List<RenderTicket *> _renderQueue;
+	/** The owned tickets in the render queue, keyed by RenderTicket::hash(). */
+	TicketIndex _ticketIndex;
+	FrameStats _frameStats;
+	FrameStats _lastFrameStats;
+	Graphics::TransformCache _transformCache;
+	DecodedImageCache _imageCache;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
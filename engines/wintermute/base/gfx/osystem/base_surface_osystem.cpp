@@ -49,14 +49,21 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 	_lockPixels = nullptr;
 	_lockPitch = 0;
 	_loaded = false;
+	_cacheable = false;
 	_rotation = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
 BaseSurfaceOSystem::~BaseSurfaceOSystem() {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	if (_surface) {
-		_surface->free();
-		delete _surface;
+		if (_cacheable) {
+			// Keep the decoded image around for when the file is loaded again
+			renderer->getImageCache().put(_filename, _ckRed, _ckGreen, _ckBlue, _surface, _alphaType);
+		} else {
+			_surface->free();
+			delete _surface;
+		}
 		_surface = nullptr;
 	}
 
@@ -64,7 +71,6 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	_alphaMask = nullptr;
 
 	_gameRef->addMem(-_width * _height * 4);
-	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 }
 
@@ -131,38 +137,73 @@ bool BaseSurfaceOSystem::create(const Common::String &filename, bool defaultCK,
 }
 
 bool BaseSurfaceOSystem::finishLoad() {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+
+	// Savegame thumbnails change whenever the slot is overwritten
+	bool cacheable = scumm_strnicmp(_filename.c_str(), "savegame:", 9) != 0;
+
+	Graphics::AlphaType alphaType;
+	Graphics::Surface *surface = nullptr;
+	if (cacheable) {
+		surface = renderer->getImageCache().take(_filename, _ckRed, _ckGreen, _ckBlue, alphaType);
+	}
+	if (!surface) {
+		surface = decodeImage();
+		if (!surface) {
+			return false;
+		}
+		alphaType = hasTransparencyType(surface);
+	}
+
+	_surface->free();
+	delete _surface;
+	_surface = surface;
+
+	// Scaled versions of the previous image are outdated now
+	renderer->getTransformCache().invalidate(this);
+
+	_width = _surface->w;
+	_height = _surface->h;
+	_alphaType = alphaType;
+	_valid = true;
+	_cacheable = cacheable;
+
+	_gameRef->addMem(_width * _height * 4);
+
+	_loaded = true;
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+Graphics::Surface *BaseSurfaceOSystem::decodeImage() const {
 	BaseImage *image = new BaseImage();
 	if (!image->loadFile(_filename)) {
 		delete image;
-		return false;
+		return nullptr;
 	}
 
-	_width = image->getSurface()->w;
-	_height = image->getSurface()->h;
-
 	bool isSaveGameGrayscale = _filename.matchString("savegame:*g", true);
 	if (isSaveGameGrayscale) {
 		warning("grayscaleConversion not yet implemented");
 		// FIBITMAP *newImg = FreeImage_ConvertToGreyscale(img); TODO
 	}
 
-	_surface->free();
-	delete _surface;
-
+	Graphics::Surface *surface;
 	bool needsColorKey = false;
 	bool replaceAlpha = true;
 	if (image->getSurface()->format.bytesPerPixel == 1) {
 		if (!image->getPalette()) {
 			error("Missing palette while loading 8bit image %s", _filename.c_str());
 		}
-		_surface = image->getSurface()->convertTo(g_system->getScreenFormat(), image->getPalette());
+		surface = image->getSurface()->convertTo(g_system->getScreenFormat(), image->getPalette());
 		needsColorKey = true;
 	} else {
 		if (image->getSurface()->format != g_system->getScreenFormat()) {
-			_surface = image->getSurface()->convertTo(g_system->getScreenFormat());
+			surface = image->getSurface()->convertTo(g_system->getScreenFormat());
 		} else {
-			_surface = new Graphics::Surface();
-			_surface->copyFrom(*image->getSurface());
+			surface = new Graphics::Surface();
+			surface->copyFrom(*image->getSurface());
 		}
 
 		if (_filename.hasSuffix(".bmp") && image->getSurface()->format.bytesPerPixel == 4) {
@@ -175,20 +216,13 @@ bool BaseSurfaceOSystem::finishLoad() {
 	}
 
 	if (needsColorKey) {
-		Graphics::TransparentSurface trans(*_surface);
+		Graphics::TransparentSurface trans(*surface);
 		trans.applyColorKey(_ckRed, _ckGreen, _ckBlue, replaceAlpha);
 	}
 
-	_alphaType = hasTransparencyType(_surface);
-	_valid = true;
-
-	_gameRef->addMem(_width * _height * 4);
-
 	delete image;
 
-	_loaded = true;
-
-	return true;
+	return surface;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -315,6 +349,7 @@ bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
 bool BaseSurfaceOSystem::startPixelOp() {
 	//SDL_LockTexture(_texture, nullptr, &_lockPixels, &_lockPitch);
 	// Any pixel-op makes the caching useless:
+	_cacheable = false;
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 	return STATUS_OK;
@@ -443,6 +478,7 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
 	_loaded = true;
+	_cacheable = false;
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
 		byte *dst = (byte *)_surface->getBasePtr(0, 0);
@@ -86,7 +86,10 @@ public:
 private:
 	Graphics::Surface *_surface;
 	bool _loaded;
+	/** Whether _surface holds the unmodified contents of _filename. */
+	bool _cacheable;
 	bool finishLoad();
+	Graphics::Surface *decodeImage() const;
 	bool drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect, Graphics::TransformStruct transformStruct);
 	void genAlphaMask(Graphics::Surface *surface);
 	uint32 getPixelAt(Graphics::Surface *surface, int x, int y);
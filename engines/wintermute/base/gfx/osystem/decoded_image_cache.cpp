@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/gfx/osystem/decoded_image_cache.h"
+#include "common/hash-str.h"
+
+namespace Wintermute {
+
+bool DecodedImageCache::Key::operator==(const Key &other) const {
+	return colorKey == other.colorKey && filename.equalsIgnoreCase(other.filename);
+}
+
+uint DecodedImageCache::KeyHash::operator()(const Key &key) const {
+	return Common::hashit_lower(key.filename.c_str()) * 31 + key.colorKey;
+}
+
+DecodedImageCache::DecodedImageCache(uint32 memoryBudget) : _memoryBudget(memoryBudget), _memoryUsage(0) {
+}
+
+DecodedImageCache::~DecodedImageCache() {
+	clear();
+}
+
+DecodedImageCache::Key DecodedImageCache::makeKey(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue) {
+	Key key;
+	key.filename = filename;
+	key.colorKey = (ckRed << 16) | (ckGreen << 8) | ckBlue;
+	return key;
+}
+
+Graphics::Surface *DecodedImageCache::take(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue, Graphics::AlphaType &alphaType) {
+	EntryMap::iterator i = _entries.find(makeKey(filename, ckRed, ckGreen, ckBlue));
+	if (i == _entries.end()) {
+		++_stats.misses;
+		return nullptr;
+	}
+
+	++_stats.hits;
+	Entry *entry = i->_value;
+	Graphics::Surface *surface = entry->surface;
+	alphaType = entry->alphaType;
+	removeEntry(entry, false);
+	return surface;
+}
+
+void DecodedImageCache::put(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue, Graphics::Surface *surface, Graphics::AlphaType alphaType) {
+	Key key = makeKey(filename, ckRed, ckGreen, ckBlue);
+
+	// Surfaces which are not shared through BaseSurfaceStorage may load the
+	// same file more than once; keep the most recent copy only
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end())
+		removeEntry(i->_value, true);
+
+	Entry *entry = new Entry();
+	entry->key = key;
+	entry->surface = surface;
+	entry->alphaType = alphaType;
+	entry->size = surface->pitch * surface->h;
+	_lru.push_front(entry);
+	entry->lruPos = _lru.begin();
+	_entries[key] = entry;
+	_memoryUsage += entry->size;
+
+	evict();
+}
+
+void DecodedImageCache::clear() {
+	while (!_lru.empty())
+		removeEntry(_lru.front(), true);
+}
+
+void DecodedImageCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evict();
+}
+
+void DecodedImageCache::removeEntry(Entry *entry, bool freeSurface) {
+	_entries.erase(entry->key);
+	_lru.erase(entry->lruPos);
+	_memoryUsage -= entry->size;
+
+	if (freeSurface) {
+		entry->surface->free();
+		delete entry->surface;
+	}
+	delete entry;
+}
+
+void DecodedImageCache::evict() {
+	while (_memoryUsage > _memoryBudget && !_lru.empty()) {
+		removeEntry(_lru.back(), true);
+		++_stats.evictions;
+	}
+}
+
+} // End of namespace Wintermute
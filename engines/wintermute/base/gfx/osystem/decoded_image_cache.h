@@ -0,0 +1,145 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_DECODED_IMAGE_CACHE_H
+#define WINTERMUTE_DECODED_IMAGE_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/str.h"
+#include "graphics/surface.h"
+#include "graphics/transparent_surface.h"
+
+namespace Wintermute {
+
+/**
+ * Cache of image files that were already decoded and converted to the
+ * screen format.
+ *
+ * BaseSurfaceStorage only shares a surface while it is referenced, so the
+ * images of a scene are freed when the scene is left and have to be
+ * decoded again when the player returns to it. Instead, surfaces hand their
+ * pixels to this cache when they are deleted, and new surfaces for the
+ * same file take them back out of it.
+ *
+ * Images are keyed by their case-insensitive file name and the color key
+ * applied to them. A cached image is owned by exactly one side at a time:
+ * take() removes it from the cache, put() gives it back.
+ *
+ * The cache evicts the least recently put images once their total size
+ * exceeds the memory budget.
+ */
+class DecodedImageCache {
+public:
+	enum {
+		kDefaultMemoryBudget = 64 * 1024 * 1024
+	};
+
+	struct Stats {
+		Stats() : hits(0), misses(0), evictions(0) {}
+
+		/** Number of images served from the cache. */
+		uint32 hits;
+		/** Number of images which had to be decoded. */
+		uint32 misses;
+		/** Number of images dropped to stay within the memory budget. */
+		uint32 evictions;
+	};
+
+	explicit DecodedImageCache(uint32 memoryBudget = kDefaultMemoryBudget);
+	~DecodedImageCache();
+
+	/**
+	 * Remove a decoded image from the cache.
+	 *
+	 * @param filename  the file the image was loaded from
+	 * @param ckRed     the red component of the applied color key
+	 * @param ckGreen   the green component of the applied color key
+	 * @param ckBlue    the blue component of the applied color key
+	 * @param alphaType set to the alpha type of the image, if found
+	 * @return the image, which the caller now owns, or nullptr if the image
+	 *         is not cached
+	 */
+	Graphics::Surface *take(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue, Graphics::AlphaType &alphaType);
+
+	/**
+	 * Hand a decoded image over to the cache, which takes ownership of it.
+	 * The pixels must be unchanged since the image was decoded.
+	 *
+	 * @see take()
+	 */
+	void put(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue, Graphics::Surface *surface, Graphics::AlphaType alphaType);
+
+	/** Drop all images. */
+	void clear();
+
+	/** Set the maximal total size of the cached images in bytes. */
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Return the total size of the cached images in bytes. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+	uint32 getNumEntries() const { return _lru.size(); }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+
+private:
+	struct Key {
+		Common::String filename;
+		uint32 colorKey;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry;
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, Entry *, KeyHash> EntryMap;
+
+	struct Entry {
+		Key key;
+		Graphics::Surface *surface;
+		Graphics::AlphaType alphaType;
+		uint32 size;
+		EntryList::iterator lruPos;
+	};
+
+	static Key makeKey(const Common::String &filename, byte ckRed, byte ckGreen, byte ckBlue);
+	void removeEntry(Entry *entry, bool freeSurface);
+	void evict();
+
+	EntryMap _entries;
+	/** The entries, most recently put first. */
+	EntryList _lru;
+
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	Stats _stats;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/gfx/osystem/render_ticket.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
 #include "graphics/transform_tools.h"
 #include "common/textconsole.h"
@@ -43,14 +44,7 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_wantsDraw(true),
 	_transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
-		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
-		}
-		// Then scale it if necessary
+		// Scale or rotate it if necessary
 		//
 		// NB: The numTimesX/numTimesY properties don't yet mix well with
 		// scaling and rotation, but there is no need for that functionality at
@@ -58,30 +52,36 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
+		const Graphics::TransparentSurface *transformed = nullptr;
 		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
+			Graphics::TransformCache &cache = static_cast<BaseRenderOSystem *>(owner->_gameRef->_renderer)->getTransformCache();
 			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+				transformed = cache.rotoscale(owner, *surf, *srcRect, transform, Graphics::FILTER_BILINEAR);
 			} else {
-				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
+				transformed = cache.rotoscale(owner, *surf, *srcRect, transform, Graphics::FILTER_NEAREST);
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
 		} else if ((dstRect->width() != srcRect->width() ||
 					dstRect->height() != srcRect->height()) &&
 					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
+			Graphics::TransformCache &cache = static_cast<BaseRenderOSystem *>(owner->_gameRef->_renderer)->getTransformCache();
 			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect->width(), dstRect->height());
+				transformed = cache.scale(owner, *surf, *srcRect, dstRect->width(), dstRect->height(), Graphics::FILTER_BILINEAR);
 			} else {
-				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
+				transformed = cache.scale(owner, *surf, *srcRect, dstRect->width(), dstRect->height(), Graphics::FILTER_NEAREST);
+			}
+		}
+
+		_surface = new Graphics::Surface();
+		if (transformed) {
+			// The cached surface may be dropped any time, so keep a copy
+			_surface->copyFrom(*transformed);
+		} else {
+			_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+			assert(_surface->format.bytesPerPixel == 4);
+			// Get a clipped copy of the surface
+			for (int i = 0; i < _surface->h; i++) {
+				memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
 		}
 	} else {
 		_surface = nullptr;
@@ -106,6 +106,15 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+uint RenderTicket::hash() const {
+	uint hash = (uint)(size_t)_owner;
+	hash = hash * 31 + (uint16)_dstRect.left + ((uint)(uint16)_dstRect.top << 16);
+	hash = hash * 31 + (uint16)_dstRect.right + ((uint)(uint16)_dstRect.bottom << 16);
+	hash = hash * 31 + (uint16)_srcRect.left + ((uint)(uint16)_srcRect.top << 16);
+	hash = hash * 31 + (uint16)_srcRect.right + ((uint)(uint16)_srcRect.bottom << 16);
+	return hash;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
@@ -23,6 +23,7 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +37,8 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("image_cache", WRAP_METHOD(Console, Cmd_ImageCache));
+	registerCmd("render_stats", WRAP_METHOD(Console, Cmd_RenderStats));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -341,6 +344,42 @@ bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ImageCache(int argc, const char **argv) {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(BaseEngine::getRenderer());
+	if (!renderer) {
+		debugPrintf("No renderer\n");
+		return true;
+	}
+
+	DecodedImageCache &cache = renderer->getImageCache();
+	if (argc == 2 && Common::String(argv[1]) == "clear") {
+		cache.clear();
+		cache.resetStats();
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [clear]\n", argv[0]);
+		return true;
+	}
+
+	const DecodedImageCache::Stats &stats = cache.getStats();
+	debugPrintf("Decoded images: %u, %u of %u KB\n", cache.getNumEntries(),
+	            cache.getMemoryUsage() / 1024, cache.getMemoryBudget() / 1024);
+	debugPrintf("Hits: %u, misses: %u, evictions: %u\n", stats.hits, stats.misses, stats.evictions);
+	return true;
+}
+
+bool Console::Cmd_RenderStats(int argc, const char **argv) {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(BaseEngine::getRenderer());
+	if (!renderer) {
+		debugPrintf("No renderer\n");
+		return true;
+	}
+
+	const BaseRenderOSystem::FrameStats &stats = renderer->getFrameStats();
+	debugPrintf("Last frame: %u tickets, %u matched, %u reordered\n", stats.tickets, stats.matched, stats.reordered);
+	debugPrintf("Redrawn: %u pixels\n", stats.dirtyArea);
+	return true;
+}
+
 
 bool Console::Cmd_SourcePath(int argc, const char **argv) {
 	if (argc != 2) {
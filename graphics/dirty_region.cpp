@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirty_region.h"
+
+#include "common/util.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion() : _width(0), _height(0), _tilesW(0), _tilesH(0), _tiles(0), _numDirtyTiles(0) {
+}
+
+DirtyRegion::~DirtyRegion() {
+	delete[] _tiles;
+}
+
+void DirtyRegion::setSize(int16 width, int16 height) {
+	delete[] _tiles;
+
+	_width = width;
+	_height = height;
+	_tilesW = (width + kTileSize - 1) / kTileSize;
+	_tilesH = (height + kTileSize - 1) / kTileSize;
+	_tiles = new TileBox[_tilesW * _tilesH];
+
+	// Force clear() to reset all tiles
+	_numDirtyTiles = 1;
+	clear();
+}
+
+void DirtyRegion::clear() {
+	if (_numDirtyTiles == 0)
+		return;
+
+	const TileBox empty = { 0xFF, 0xFF, 0, 0 };
+	for (int i = 0; i < _tilesW * _tilesH; ++i)
+		_tiles[i] = empty;
+	_numDirtyTiles = 0;
+}
+
+void DirtyRegion::addRect(const Common::Rect &r) {
+	Common::Rect rect(r);
+	rect.clip(_width, _height);
+	if (rect.isEmpty())
+		return;
+
+	const int tx0 = rect.left / kTileSize;
+	const int ty0 = rect.top / kTileSize;
+	const int tx1 = (rect.right - 1) / kTileSize;
+	const int ty1 = (rect.bottom - 1) / kTileSize;
+
+	for (int ty = ty0; ty <= ty1; ++ty) {
+		const byte top = (ty == ty0) ? rect.top % kTileSize : 0;
+		const byte bottom = (ty == ty1) ? (rect.bottom - 1) % kTileSize : kTileSize - 1;
+
+		TileBox *box = _tiles + ty * _tilesW + tx0;
+		for (int tx = tx0; tx <= tx1; ++tx, ++box) {
+			const byte left = (tx == tx0) ? rect.left % kTileSize : 0;
+			const byte right = (tx == tx1) ? (rect.right - 1) % kTileSize : kTileSize - 1;
+
+			if (box->isEmpty()) {
+				box->left = left;
+				box->top = top;
+				box->right = right;
+				box->bottom = bottom;
+				++_numDirtyTiles;
+			} else {
+				box->left = MIN(box->left, left);
+				box->top = MIN(box->top, top);
+				box->right = MAX(box->right, right);
+				box->bottom = MAX(box->bottom, bottom);
+			}
+		}
+	}
+}
+
+void DirtyRegion::getRects(Common::Array<Common::Rect> &rects) const {
+	rects.clear();
+	if (isEmpty())
+		return;
+
+	// Indices of the rects which reach down to the current tile row, and
+	// can hence be extended by boxes in it.
+	Common::Array<uint> open, nextOpen;
+
+	for (int ty = 0; ty < _tilesH; ++ty) {
+		const TileBox *row = _tiles + ty * _tilesW;
+		const int16 rowTop = ty * kTileSize;
+
+		for (int tx = 0; tx < _tilesW; ++tx) {
+			const TileBox &box = row[tx];
+			if (box.isEmpty())
+				continue;
+
+			Common::Rect span(tx * kTileSize + box.left, rowTop + box.top,
+			                  tx * kTileSize + box.right + 1, rowTop + box.bottom + 1);
+
+			// Join the boxes of the following tiles, as long as they
+			// continue this one seamlessly.
+			while (tx + 1 < _tilesW && row[tx].right == kTileSize - 1) {
+				const TileBox &next = row[tx + 1];
+				if (next.isEmpty() || next.left != 0 || next.top != box.top || next.bottom != box.bottom)
+					break;
+
+				++tx;
+				span.right = tx * kTileSize + next.right + 1;
+			}
+
+			// Join the span with a rect of the same width ending right
+			// above it.
+			uint index = rects.size();
+			if (box.top == 0) {
+				for (uint i = 0; i < open.size(); ++i) {
+					Common::Rect &above = rects[open[i]];
+					if (above.left == span.left && above.right == span.right) {
+						above.bottom = span.bottom;
+						index = open[i];
+						break;
+					}
+				}
+			}
+
+			if (index == rects.size())
+				rects.push_back(span);
+
+			if (span.bottom == rowTop + kTileSize)
+				nextOpen.push_back(index);
+		}
+
+		open = nextOpen;
+		nextOpen.clear();
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTY_REGION_H
+#define GRAPHICS_DIRTY_REGION_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * Keeps track of the changed areas of a screen.
+ *
+ * The screen is divided into square tiles, and for every tile the bounding
+ * box of its changed pixels is stored (similar to the micro tiles used by
+ * the Sword25 engine). Hence any number of rects can be added at constant
+ * cost and memory, overlapping rects are merged automatically, and the
+ * area to redraw never grows by more than the size of a tile per rect.
+ *
+ * When reading back the dirty area, the tile boxes are joined into as few
+ * non-overlapping rects as possible without covering additional pixels.
+ */
+class DirtyRegion {
+public:
+	enum {
+		kTileSize = 16
+	};
+
+	DirtyRegion();
+	~DirtyRegion();
+
+	/**
+	 * Set the size of the tracked area. This also clears all dirty rects.
+	 */
+	void setSize(int16 width, int16 height);
+
+	int16 getWidth() const { return _width; }
+	int16 getHeight() const { return _height; }
+
+	/**
+	 * Mark the given area as dirty. Parts outside of the tracked area are
+	 * ignored.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/** Mark everything as clean again. */
+	void clear();
+
+	/** Query whether any area is dirty. */
+	bool isEmpty() const { return _numDirtyTiles == 0; }
+
+	/**
+	 * Get the dirty area as a list of non-overlapping rects, ordered from
+	 * top to bottom.
+	 *
+	 * @param rects the array the rects are written to; it is cleared first
+	 */
+	void getRects(Common::Array<Common::Rect> &rects) const;
+
+private:
+	/**
+	 * Bounding box of the dirty pixels in a tile, relative to the tile.
+	 * Unlike Common::Rect, the right and bottom coordinates are inclusive.
+	 * An empty tile has left > right.
+	 */
+	struct TileBox {
+		byte left, top, right, bottom;
+
+		bool isEmpty() const { return left > right; }
+	};
+
+	int16 _width, _height;
+	int _tilesW, _tilesH;
+	TileBox *_tiles;
+	int _numDirtyTiles;
+};
+
+} // End of namespace Graphics
+
+#endif
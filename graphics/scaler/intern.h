@@ -26,6 +26,11 @@
 #include "common/scummsys.h"
 #include "graphics/colormasks.h"
 
+#if defined(__SSE2__)
+#define USE_SSE2_HQ_PATTERN
+#include <emmintrin.h>
+#endif
+
 
 /**
  * Interpolate two 16 bit pixel *pairs* at once with equal weights 1.
@@ -218,4 +223,42 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+/**
+ * Compute the pattern used by the hq scaler family to pick the
+ * interpolation for a pixel. Bit n is set if the n-th neighbour (in the
+ * order w1, w2, w3, w4, w6, w7, w8, w9) differs from the centre pixel w5
+ * according to diffYUV().
+ */
+static inline int hqPattern(int yuv5, int yuv1, int yuv2, int yuv3, int yuv4, int yuv6, int yuv7, int yuv8, int yuv9) {
+#ifdef USE_SSE2_HQ_PATTERN
+	// Compare all eight neighbours at once. The Y, U and V components each
+	// fit into a byte, so the absolute differences can be computed with
+	// saturating byte arithmetic. The threshold for the unused top byte
+	// can never be exceeded.
+	const __m128i threshold = _mm_set1_epi32((int)0xFF300706);
+	const __m128i centre = _mm_set1_epi32(yuv5);
+	const __m128i neighbours0 = _mm_set_epi32(yuv4, yuv3, yuv2, yuv1);
+	const __m128i neighbours1 = _mm_set_epi32(yuv9, yuv8, yuv7, yuv6);
+
+	__m128i diff0 = _mm_or_si128(_mm_subs_epu8(neighbours0, centre), _mm_subs_epu8(centre, neighbours0));
+	__m128i diff1 = _mm_or_si128(_mm_subs_epu8(neighbours1, centre), _mm_subs_epu8(centre, neighbours1));
+	diff0 = _mm_cmpeq_epi32(_mm_subs_epu8(diff0, threshold), _mm_setzero_si128());
+	diff1 = _mm_cmpeq_epi32(_mm_subs_epu8(diff1, threshold), _mm_setzero_si128());
+
+	const int similar = _mm_movemask_ps(_mm_castsi128_ps(diff0)) | (_mm_movemask_ps(_mm_castsi128_ps(diff1)) << 4);
+	return similar ^ 0xFF;
+#else
+	int pattern = 0;
+	if (yuv5 != yuv1 && diffYUV(yuv5, yuv1)) pattern |= 0x0001;
+	if (yuv5 != yuv2 && diffYUV(yuv5, yuv2)) pattern |= 0x0002;
+	if (yuv5 != yuv3 && diffYUV(yuv5, yuv3)) pattern |= 0x0004;
+	if (yuv5 != yuv4 && diffYUV(yuv5, yuv4)) pattern |= 0x0008;
+	if (yuv5 != yuv6 && diffYUV(yuv5, yuv6)) pattern |= 0x0010;
+	if (yuv5 != yuv7 && diffYUV(yuv5, yuv7)) pattern |= 0x0020;
+	if (yuv5 != yuv8 && diffYUV(yuv5, yuv8)) pattern |= 0x0040;
+	if (yuv5 != yuv9 && diffYUV(yuv5, yuv9)) pattern |= 0x0080;
+	return pattern;
+#endif
+}
+
 #endif
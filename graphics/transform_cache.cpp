@@ -0,0 +1,173 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transform_cache.h"
+
+namespace Graphics {
+
+bool TransformCache::Key::operator==(const Key &other) const {
+	return sourceId == other.sourceId &&
+	       srcRect == other.srcRect &&
+	       filteringMode == other.filteringMode &&
+	       rotate == other.rotate &&
+	       width == other.width &&
+	       height == other.height &&
+	       angle == other.angle &&
+	       zoom == other.zoom &&
+	       hotspot == other.hotspot;
+}
+
+uint TransformCache::KeyHash::operator()(const Key &key) const {
+	uint hash = (uint)(size_t)key.sourceId;
+	hash = hash * 31 + (uint16)key.srcRect.left + ((uint)(uint16)key.srcRect.top << 16);
+	hash = hash * 31 + (uint16)key.srcRect.right + ((uint)(uint16)key.srcRect.bottom << 16);
+	hash = hash * 31 + key.width + ((uint)key.height << 16);
+	hash = hash * 31 + (uint)key.angle + ((uint)key.filteringMode << 16) + ((uint)key.rotate << 24);
+	hash = hash * 31 + (uint16)key.zoom.x + ((uint)(uint16)key.zoom.y << 16);
+	hash = hash * 31 + (uint16)key.hotspot.x + ((uint)(uint16)key.hotspot.y << 16);
+	return hash;
+}
+
+TransformCache::TransformCache(uint32 memoryBudget) : _memoryBudget(memoryBudget), _memoryUsage(0) {
+}
+
+TransformCache::~TransformCache() {
+	clear();
+}
+
+const TransparentSurface *TransformCache::scale(const void *sourceId, const Surface &source, const Common::Rect &srcRect,
+                                                uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode) {
+	Key key;
+	key.sourceId = sourceId;
+	key.srcRect = srcRect;
+	key.filteringMode = filteringMode;
+	key.rotate = false;
+	key.width = newWidth;
+	key.height = newHeight;
+	key.angle = 0;
+	key.zoom = Common::Point();
+	key.hotspot = Common::Point();
+	return lookup(key, source);
+}
+
+const TransparentSurface *TransformCache::rotoscale(const void *sourceId, const Surface &source, const Common::Rect &srcRect,
+                                                    const TransformStruct &transform, TFilteringMode filteringMode) {
+	// Only the parameters actually used by rotoscaleT are part of the key,
+	// so that e.g. fading a rotated sprite does not recompute it.
+	Key key;
+	key.sourceId = sourceId;
+	key.srcRect = srcRect;
+	key.filteringMode = filteringMode;
+	key.rotate = true;
+	key.width = 0;
+	key.height = 0;
+	key.angle = transform._angle;
+	key.zoom = transform._zoom;
+	key.hotspot = transform._hotspot;
+	return lookup(key, source);
+}
+
+const TransparentSurface *TransformCache::lookup(const Key &key, const Surface &source) {
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		Entry *entry = i->_value;
+		if (entry->lruPos != _lru.begin()) {
+			_lru.erase(entry->lruPos);
+			_lru.push_front(entry);
+			entry->lruPos = _lru.begin();
+		}
+		++_stats.hits;
+		return entry->surface;
+	}
+
+	++_stats.misses;
+
+	// The transformations expect the pixels to be stored without gaps
+	TransparentSurface area;
+	area.copyFrom(source.getSubArea(key.srcRect));
+
+	TransparentSurface *surface;
+	if (key.rotate) {
+		const TransformStruct transform(key.zoom.x, key.zoom.y, (uint32)key.angle, key.hotspot.x, key.hotspot.y);
+		if (key.filteringMode == FILTER_BILINEAR)
+			surface = area.rotoscaleT<FILTER_BILINEAR>(transform);
+		else
+			surface = area.rotoscaleT<FILTER_NEAREST>(transform);
+	} else {
+		if (key.filteringMode == FILTER_BILINEAR)
+			surface = area.scaleT<FILTER_BILINEAR>(key.width, key.height);
+		else
+			surface = area.scaleT<FILTER_NEAREST>(key.width, key.height);
+	}
+	area.free();
+
+	Entry *entry = new Entry();
+	entry->key = key;
+	entry->surface = surface;
+	entry->size = surface->pitch * surface->h;
+	_lru.push_front(entry);
+	entry->lruPos = _lru.begin();
+	_entries[key] = entry;
+	_memoryUsage += entry->size;
+
+	evict(entry);
+	return surface;
+}
+
+void TransformCache::invalidate(const void *sourceId) {
+	EntryList::iterator i = _lru.begin();
+	while (i != _lru.end()) {
+		Entry *entry = *i;
+		++i;
+		if (entry->key.sourceId == sourceId)
+			removeEntry(entry);
+	}
+}
+
+void TransformCache::clear() {
+	while (!_lru.empty())
+		removeEntry(_lru.front());
+}
+
+void TransformCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evict(nullptr);
+}
+
+void TransformCache::removeEntry(Entry *entry) {
+	_entries.erase(entry->key);
+	_lru.erase(entry->lruPos);
+	_memoryUsage -= entry->size;
+
+	entry->surface->free();
+	delete entry->surface;
+	delete entry;
+}
+
+void TransformCache::evict(const Entry *keep) {
+	while (_memoryUsage > _memoryBudget && !_lru.empty() && _lru.back() != keep) {
+		removeEntry(_lru.back());
+		++_stats.evictions;
+	}
+}
+
+} // End of namespace Graphics
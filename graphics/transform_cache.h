@@ -0,0 +1,164 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_TRANSFORM_CACHE_H
+#define GRAPHICS_TRANSFORM_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/rect.h"
+#include "graphics/transform_struct.h"
+#include "graphics/transparent_surface.h"
+
+namespace Graphics {
+
+/**
+ * Cache of scaled and rotated versions of surfaces.
+ *
+ * Engines tend to draw the same sprite with the same transformation in
+ * every frame, e.g. an actor walking through a scaled part of a scene.
+ * This keeps the most recently used results of
+ * TransparentSurface::scaleT() and rotoscaleT(), so that only a copy of
+ * them needs to be made in this case.
+ *
+ * The sources are identified by an arbitrary pointer chosen by the
+ * caller, usually the object owning the source surface, together with the
+ * source area. Whenever the contents of a source change, or its
+ * identifying pointer is freed, invalidate() must be called for it.
+ *
+ * The cache evicts the least recently used results once their total size
+ * exceeds the memory budget.
+ */
+class TransformCache {
+public:
+	enum {
+		kDefaultMemoryBudget = 16 * 1024 * 1024
+	};
+
+	struct Stats {
+		Stats() : hits(0), misses(0), evictions(0) {}
+
+		/** Number of requests served from the cache. */
+		uint32 hits;
+		/** Number of requests which had to be computed. */
+		uint32 misses;
+		/** Number of results dropped to stay within the memory budget. */
+		uint32 evictions;
+	};
+
+	explicit TransformCache(uint32 memoryBudget = kDefaultMemoryBudget);
+	~TransformCache();
+
+	/**
+	 * Get an area of a surface scaled to the given size, like
+	 * TransparentSurface::scaleT() would return it.
+	 *
+	 * @param sourceId      identifies the contents of source
+	 * @param source        the surface to scale, in the format supported
+	 *                      by TransparentSurface
+	 * @param srcRect       the area of source to scale
+	 * @param newWidth      the resulting width
+	 * @param newHeight     the resulting height
+	 * @param filteringMode the filter to scale with
+	 * @return the scaled surface. It is owned by the cache and stays valid
+	 *         until the next call of any method of the cache.
+	 */
+	const TransparentSurface *scale(const void *sourceId, const Surface &source, const Common::Rect &srcRect,
+	                                uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode);
+
+	/**
+	 * Get an area of a surface transformed like
+	 * TransparentSurface::rotoscaleT() would return it.
+	 *
+	 * @see scale()
+	 */
+	const TransparentSurface *rotoscale(const void *sourceId, const Surface &source, const Common::Rect &srcRect,
+	                                    const TransformStruct &transform, TFilteringMode filteringMode);
+
+	/** Drop all results computed from the given source. */
+	void invalidate(const void *sourceId);
+
+	/** Drop all results. */
+	void clear();
+
+	/**
+	 * Set the maximal total size of the cached results in bytes. The most
+	 * recent result is always kept until the next request, even if it
+	 * exceeds the budget on its own.
+	 */
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Return the total size of the cached results in bytes. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+	uint32 getNumEntries() const { return _lru.size(); }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+
+private:
+	/** All parameters the result of a transformation depends on. */
+	struct Key {
+		const void *sourceId;
+		Common::Rect srcRect;
+		TFilteringMode filteringMode;
+		bool rotate;
+		uint16 width, height;
+		int32 angle;
+		Common::Point zoom;
+		Common::Point hotspot;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry;
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, Entry *, KeyHash> EntryMap;
+
+	struct Entry {
+		Key key;
+		TransparentSurface *surface;
+		uint32 size;
+		EntryList::iterator lruPos;
+	};
+
+	const TransparentSurface *lookup(const Key &key, const Surface &source);
+	void removeEntry(Entry *entry);
+	void evict(const Entry *keep);
+
+	EntryMap _entries;
+	/** The entries, most recently used first. */
+	EntryList _lru;
+
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	Stats _stats;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -37,6 +37,13 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+// The blending kernels below process four pixels at once with SSE2. This
+// relies on the alpha channel being stored in the lowest byte of a pixel.
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#define USE_SSE2_BLENDING
+#include <emmintrin.h>
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -129,6 +136,135 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	}
 }
 
+#ifdef USE_SSE2_BLENDING
+
+enum BlendKernel {
+	kBlendAlpha,
+	kBlendAdditive,
+	kBlendSubtractive,
+	kBlendMultiply
+};
+
+/**
+ * The factors of a colormod, laid out like a pixel unpacked to 16 bit
+ * lanes (A, B, G, R per pixel).
+ */
+struct BlendMod {
+	BlendMod(uint32 color) {
+		const int16 ca = (color >> kAModShift) & 0xFF;
+		const int16 cr = (color >> kRModShift) & 0xFF;
+		const int16 cg = (color >> kGModShift) & 0xFF;
+		const int16 cb = (color >> kBModShift) & 0xFF;
+
+		alpha = _mm_set1_epi16(ca);
+		rgb = _mm_set_epi16(cr, cg, cb, 0, cr, cg, cb, 0);
+		// Where the scalar code skips the multiplication with a factor of
+		// 255, it shifts by 8 bits less instead. Multiplying with 256
+		// before taking the high 16 bits of the product does the same.
+		rgbSkip255 = _mm_set_epi16(cr == 255 ? 256 : cr, cg == 255 ? 256 : cg, cb == 255 ? 256 : cb, 0,
+		                           cr == 255 ? 256 : cr, cg == 255 ? 256 : cg, cb == 255 ? 256 : cb, 0);
+	}
+
+	__m128i alpha;
+	__m128i rgb;
+	__m128i rgbSkip255;
+};
+
+/**
+ * Blend two pixels of src onto dst, with the same arithmetic as the scalar
+ * code. Both are unpacked to 16 bit lanes. The alpha lanes of the result
+ * are fixed up by the caller.
+ */
+template<BlendKernel kernel, bool tinted>
+static inline __m128i blendPixels(__m128i src, __m128i dst, const BlendMod &mod) {
+	const __m128i colorLanes = _mm_set_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+	const __m128i full = _mm_set1_epi16(255);
+
+	// Spread the alpha value of each pixel to all of its lanes
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0), 0);
+	if (tinted && kernel != kBlendSubtractive)
+		alpha = _mm_srli_epi16(_mm_mullo_epi16(alpha, mod.alpha), 8);
+
+	switch (kernel) {
+	case kBlendAlpha:
+		if (tinted) {
+			const __m128i dstPart = _mm_srli_epi16(_mm_mullo_epi16(dst, _mm_sub_epi16(full, alpha)), 8);
+			return _mm_add_epi16(dstPart, _mm_mulhi_epu16(_mm_mullo_epi16(src, alpha), mod.rgb));
+		}
+		return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, _mm_sub_epi16(full, alpha))), 8);
+
+	case kBlendAdditive:
+		if (tinted)
+			return _mm_add_epi16(dst, _mm_mulhi_epu16(_mm_mullo_epi16(src, alpha), mod.rgbSkip255));
+		return _mm_add_epi16(dst, _mm_srli_epi16(_mm_mullo_epi16(src, _mm_and_si128(alpha, colorLanes)), 8));
+
+	case kBlendSubtractive:
+		// The product of the two source factors is exact in 16 bits, and
+		// so is the product of the others.
+		if (tinted)
+			return _mm_sub_epi16(dst, _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(src, dst), _mm_mullo_epi16(alpha, mod.rgbSkip255)), 8));
+		return _mm_sub_epi16(dst, _mm_mulhi_epu16(_mm_mullo_epi16(src, dst), _mm_and_si128(alpha, colorLanes)));
+
+	case kBlendMultiply:
+	default:
+		if (tinted)
+			src = _mm_mulhi_epu16(_mm_mullo_epi16(src, alpha), mod.rgbSkip255);
+		else
+			src = _mm_srli_epi16(_mm_mullo_epi16(src, alpha), 8);
+		return _mm_srli_epi16(_mm_mullo_epi16(src, dst), 8);
+	}
+}
+
+/**
+ * Blend as many pixels of a row as possible in groups of four, and advance
+ * in and out past them. The remaining pixels are left to the scalar code.
+ */
+template<BlendKernel kernel, bool tinted>
+static uint32 blendRowSSE2(byte *&in, byte *&out, uint32 width, int32 inStep, const BlendMod &mod) {
+	// Only plain and horizontally flipped rows can be loaded as a whole
+	if (inStep != 4 && inStep != -4)
+		return 0;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		__m128i src;
+		if (inStep > 0) {
+			src = _mm_loadu_si128((const __m128i *)in);
+		} else {
+			src = _mm_loadu_si128((const __m128i *)(in - 12));
+			src = _mm_shuffle_epi32(src, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		const __m128i lo = blendPixels<kernel, tinted>(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), mod);
+		const __m128i hi = blendPixels<kernel, tinted>(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), mod);
+		__m128i result = _mm_packus_epi16(lo, hi);
+
+		if (kernel == kBlendAlpha || (kernel == kBlendSubtractive && tinted)) {
+			result = _mm_or_si128(result, alphaMask);
+		} else if (kernel == kBlendMultiply) {
+			result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(dst, alphaMask));
+		}
+
+		// Skip fully transparent pixels, where the scalar code does
+		if (!tinted && (kernel == kBlendAlpha || kernel == kBlendMultiply)) {
+			const __m128i skip = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+			result = _mm_or_si128(_mm_andnot_si128(skip, result), _mm_and_si128(skip, dst));
+		}
+
+		_mm_storeu_si128((__m128i *)out, result);
+		in += 4 * inStep;
+		out += 16;
+	}
+
+	return j;
+}
+
+#endif
+
 /**
  * Optimized version of doBlit to be used with alpha blended blitting
  * @param ino a pointer to the input surface
@@ -143,13 +279,20 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#ifdef USE_SSE2_BLENDING
+	const BlendMod mod(color);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendAlpha, false>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -174,7 +317,11 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendAlpha, true>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 				out[kAIndex] = 255;
@@ -201,13 +348,20 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#ifdef USE_SSE2_BLENDING
+	const BlendMod mod(color);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendAdditive, false>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) + out[kRIndex], 255);
@@ -231,7 +385,11 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendAdditive, true>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -268,13 +426,20 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#ifdef USE_SSE2_BLENDING
+	const BlendMod mod(color);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendSubtractive, false>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * out[kRIndex]) * in[kAIndex] >> 16), 0);
@@ -297,7 +462,11 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendSubtractive, true>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
@@ -333,12 +502,19 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#ifdef USE_SSE2_BLENDING
+	const BlendMod mod(color);
+#endif
 
 	if (color == 0xffffffff) {
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendMultiply, false>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) * out[kRIndex] >> 8, 255);
@@ -361,7 +537,11 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			j = blendRowSSE2<kBlendMultiply, true>(in, out, width, inStep, mod);
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -83,9 +83,17 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/util.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+// The SSE2 conversion writes eight pixels at once, in little endian order.
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#define USE_SSE2_YUV
+#include <emmintrin.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -192,6 +200,294 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+#ifdef USE_SSE2_YUV
+
+// The SSE2 conversion computes the color channels arithmetically, eight
+// pixels at a time, instead of through the lookup tables. The products
+// with the chroma are computed with fixed point factors, which give the
+// same results as the float factors of the color tables for all possible
+// values. Pixels at the end of a row which do not fill a group are
+// converted through the lookup tables.
+
+enum {
+	/** The number of pixels of a YUV410 row whose chroma is prepared at once. */
+	kRowChunk410 = 256
+};
+
+/**
+ * The pixel format and luminance scale of a conversion, prepared for SSE2.
+ * Pixels are put together in 16 bit lanes, so 32 bit pixels are handled
+ * as two halves. Formats with a color channel in both halves are not
+ * supported.
+ */
+struct SSE2PixelFormat {
+	SSE2PixelFormat(const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+		supported = true;
+		setChannel(format, format.rLoss, format.rShift, rLoss, rShiftLow, rShiftHigh);
+		setChannel(format, format.gLoss, format.gShift, gLoss, gShiftLow, gShiftHigh);
+		setChannel(format, format.bLoss, format.bShift, bLoss, bShiftLow, bShiftHigh);
+
+		const uint32 alphaBits = (0xFF >> format.aLoss) << format.aShift;
+		alphaLow = _mm_set1_epi16((int16)(alphaBits & 0xFFFF));
+		alphaHigh = _mm_set1_epi16((int16)(alphaBits >> 16));
+
+		itu = (scale == YUVToRGBManager::kScaleITU);
+		minValue = _mm_set1_epi16(itu ? 16 : 0);
+		maxValue = _mm_set1_epi16(itu ? 235 : 255);
+	}
+
+	void setChannel(const Graphics::PixelFormat &format, int loss, int shift, __m128i &lossCount, __m128i &shiftLow, __m128i &shiftHigh) {
+		// Shifting a 16 bit lane by 16 clears it
+		int low = 16, high = 16;
+		if (shift >= 16)
+			high = shift - 16;
+		else if (shift + 8 - loss <= 16)
+			low = shift;
+		else
+			supported = false;
+
+		if (format.bytesPerPixel == 2)
+			low = shift;
+
+		lossCount = _mm_cvtsi32_si128(loss);
+		shiftLow = _mm_cvtsi32_si128(low);
+		shiftHigh = _mm_cvtsi32_si128(high);
+	}
+
+	__m128i rLoss, gLoss, bLoss;
+	__m128i rShiftLow, gShiftLow, bShiftLow;
+	__m128i rShiftHigh, gShiftHigh, bShiftHigh;
+	__m128i alphaLow, alphaHigh;
+	__m128i minValue, maxValue;
+	bool itu;
+	bool supported;
+};
+
+/**
+ * Multiply the magnitude of the chroma, which is at most 128, with a fixed
+ * point factor with at least 8 fractional bits, rounding down.
+ */
+static inline __m128i mulChroma(__m128i magnitude, int16 factor, int bits) {
+	return _mm_mulhi_epu16(_mm_slli_epi16(magnitude, 16 - bits), _mm_set1_epi16(factor));
+}
+
+/** Apply the sign mask to value, i.e. negate it where the mask is set. */
+static inline __m128i applySign(__m128i value, __m128i sign) {
+	return _mm_sub_epi16(_mm_xor_si128(value, sign), sign);
+}
+
+/**
+ * Compute the offsets of the color channels from the luminance for eight
+ * pixels, like the color tables do.
+ */
+static inline void convertChroma(__m128i u, __m128i v, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i cr = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	const __m128i cb = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	const __m128i crSign = _mm_srai_epi16(cr, 15);
+	const __m128i cbSign = _mm_srai_epi16(cb, 15);
+	const __m128i crMagnitude = applySign(cr, crSign);
+	const __m128i cbMagnitude = applySign(cb, cbSign);
+	const __m128i allSet = _mm_set1_epi16(-1);
+
+	// The float factors of the color tables round towards zero
+	r = applySign(mulChroma(crMagnitude, 717, 9), crSign);                         // 0.419 / 0.299
+	g = _mm_add_epi16(applySign(mulChroma(crMagnitude, 731, 10), _mm_xor_si128(crSign, allSet)),  // -0.299 / 0.419
+	                  applySign(mulChroma(cbMagnitude, 2821, 13), _mm_xor_si128(cbSign, allSet))); // -0.114 / 0.331
+	b = applySign(mulChroma(cbMagnitude, 29055, 14), cbSign);                      // 0.587 / 0.331
+}
+
+/** Clamp and scale a color channel of eight pixels to [0, 255]. */
+static inline __m128i scaleChannel(__m128i c, const SSE2PixelFormat &format) {
+	c = _mm_min_epi16(_mm_max_epi16(c, format.minValue), format.maxValue);
+
+	// (c - 16) * 255 / 219, which this computes exactly for 16 <= c <= 235
+	if (format.itu)
+		c = _mm_mulhi_epu16(_mm_slli_epi16(_mm_sub_epi16(c, format.minValue), 3), _mm_set1_epi16(9539));
+
+	return c;
+}
+
+static inline void storePixels(uint16 *dst, __m128i r, __m128i g, __m128i b, const SSE2PixelFormat &format) {
+	r = _mm_sll_epi16(_mm_srl_epi16(r, format.rLoss), format.rShiftLow);
+	g = _mm_sll_epi16(_mm_srl_epi16(g, format.gLoss), format.gShiftLow);
+	b = _mm_sll_epi16(_mm_srl_epi16(b, format.bLoss), format.bShiftLow);
+
+	_mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_or_si128(format.alphaLow, r), _mm_or_si128(g, b)));
+}
+
+static inline void storePixels(uint32 *dst, __m128i r, __m128i g, __m128i b, const SSE2PixelFormat &format) {
+	r = _mm_srl_epi16(r, format.rLoss);
+	g = _mm_srl_epi16(g, format.gLoss);
+	b = _mm_srl_epi16(b, format.bLoss);
+
+	const __m128i low = _mm_or_si128(_mm_or_si128(format.alphaLow, _mm_sll_epi16(r, format.rShiftLow)),
+	                                 _mm_or_si128(_mm_sll_epi16(g, format.gShiftLow), _mm_sll_epi16(b, format.bShiftLow)));
+	const __m128i high = _mm_or_si128(_mm_or_si128(format.alphaHigh, _mm_sll_epi16(r, format.rShiftHigh)),
+	                                  _mm_or_si128(_mm_sll_epi16(g, format.gShiftHigh), _mm_sll_epi16(b, format.bShiftHigh)));
+
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(low, high));
+	_mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(low, high));
+}
+
+/** Convert eight pixels, given their luminance and their chroma offsets. */
+template<typename PixelInt>
+static inline void convertPixels(PixelInt *dst, const byte *ySrc, __m128i r, __m128i g, __m128i b, const SSE2PixelFormat &format) {
+	const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), _mm_setzero_si128());
+
+	storePixels(dst,
+	            scaleChannel(_mm_add_epi16(y, r), format),
+	            scaleChannel(_mm_add_epi16(y, g), format),
+	            scaleChannel(_mm_add_epi16(y, b), format),
+	            format);
+}
+
+static inline __m128i loadBytes(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+/** Convert a single pixel through the lookup tables. */
+template<typename PixelInt>
+static inline void convertPixel(PixelInt *dst, const uint32 *rgbToPix, const int16 *colorTab, byte y, byte u, byte v) {
+	const uint32 *L = &rgbToPix[y];
+	*dst = (PixelInt)(L[colorTab[0 * 256 + v]] | L[colorTab[1 * 256 + v] + colorTab[2 * 256 + u]] | L[colorTab[3 * 256 + u]]);
+}
+
+template<typename PixelInt>
+void convertYUV444ToRGBSSE2(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const SSE2PixelFormat &sse2Format, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// A local copy, which the compiler knows is not changed by the stores
+	const SSE2PixelFormat format = sse2Format;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+
+	for (int h = 0; h < yHeight; h++) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+
+		int x = 0;
+		for (; x + 8 <= yWidth; x += 8) {
+			__m128i r, g, b;
+			convertChroma(loadBytes(uSrc + x), loadBytes(vSrc + x), r, g, b);
+			convertPixels(dst + x, ySrc + x, r, g, b, format);
+		}
+
+		for (; x < yWidth; x++)
+			convertPixel(dst + x, rgbToPix, colorTab, ySrc[x], uSrc[x], vSrc[x]);
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+void convertYUV420ToRGBSSE2(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const SSE2PixelFormat &sse2Format, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// A local copy, which the compiler knows is not changed by the stores
+	const SSE2PixelFormat format = sse2Format;
+	const uint32 *rgbToPix = lookup->getRGBToPix();
+
+	for (int h = 0; h < yHeight; h += 2) {
+		PixelInt *dst1 = (PixelInt *)dstPtr;
+		PixelInt *dst2 = (PixelInt *)(dstPtr + dstPitch);
+		const byte *ySrc2 = ySrc + yPitch;
+
+		// Eight chroma samples cover 16 pixels of both rows
+		int x = 0;
+		for (; x + 16 <= yWidth; x += 16) {
+			__m128i r, g, b;
+			convertChroma(loadBytes(uSrc + (x >> 1)), loadBytes(vSrc + (x >> 1)), r, g, b);
+
+			const __m128i rLo = _mm_unpacklo_epi16(r, r), rHi = _mm_unpackhi_epi16(r, r);
+			const __m128i gLo = _mm_unpacklo_epi16(g, g), gHi = _mm_unpackhi_epi16(g, g);
+			const __m128i bLo = _mm_unpacklo_epi16(b, b), bHi = _mm_unpackhi_epi16(b, b);
+
+			convertPixels(dst1 + x, ySrc + x, rLo, gLo, bLo, format);
+			convertPixels(dst1 + x + 8, ySrc + x + 8, rHi, gHi, bHi, format);
+			convertPixels(dst2 + x, ySrc2 + x, rLo, gLo, bLo, format);
+			convertPixels(dst2 + x + 8, ySrc2 + x + 8, rHi, gHi, bHi, format);
+		}
+
+		for (; x < yWidth; x++) {
+			const byte u = uSrc[x >> 1], v = vSrc[x >> 1];
+			convertPixel(dst1 + x, rgbToPix, colorTab, ySrc[x], u, v);
+			convertPixel(dst2 + x, rgbToPix, colorTab, ySrc2[x], u, v);
+		}
+
+		dstPtr += dstPitch << 1;
+		ySrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+/**
+ * Interpolate a chroma plane of YUV410 vertically for a chunk of a row.
+ * The horizontal interpolation of convertYUV410ToRGB() is then applied
+ * to these.
+ */
+static inline void interpolate410Column(int16 *dst, const byte *src, int uvPitch, int yDiff, int count) {
+	for (int i = 0; i < count; i++)
+		dst[i] = src[i] * (4 - yDiff) + src[i + uvPitch] * yDiff;
+}
+
+/** Interpolate the chroma of eight pixels horizontally, starting at column. */
+static inline __m128i interpolate410Row(const int16 *column) {
+	const __m128i xDiff = _mm_setr_epi16(0, 1, 2, 3, 0, 1, 2, 3);
+
+	__m128i left = _mm_loadl_epi64((const __m128i *)column);
+	left = _mm_unpacklo_epi16(left, left);
+	const __m128i right = _mm_unpacklo_epi32(_mm_srli_si128(left, 4), _mm_srli_si128(left, 4));
+	left = _mm_unpacklo_epi32(left, left);
+
+	// (left * (4 - xDiff) + right * xDiff) >> 4
+	const __m128i sum = _mm_add_epi16(_mm_slli_epi16(left, 2), _mm_mullo_epi16(_mm_sub_epi16(right, left), xDiff));
+	return _mm_srli_epi16(sum, 4);
+}
+
+template<typename PixelInt>
+void convertYUV410ToRGBSSE2(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const SSE2PixelFormat &sse2Format, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// A local copy, which the compiler knows is not changed by the stores
+	const SSE2PixelFormat format = sse2Format;
+
+	// One extra column for the interpolation, and padding for loading
+	// four columns at once
+	int16 uColumns[kRowChunk410 / 4 + 4] = { 0 };
+	int16 vColumns[kRowChunk410 / 4 + 4] = { 0 };
+
+	for (int y = 0; y < yHeight; y++) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+		const int yDiff = y & 3;
+		const byte *uRow = uSrc + (y >> 2) * uvPitch;
+		const byte *vRow = vSrc + (y >> 2) * uvPitch;
+
+		for (int chunk = 0; chunk < yWidth; chunk += kRowChunk410) {
+			const int width = MIN<int>(yWidth - chunk, kRowChunk410);
+			interpolate410Column(uColumns, uRow + (chunk >> 2), uvPitch, yDiff, (width >> 2) + 1);
+			interpolate410Column(vColumns, vRow + (chunk >> 2), uvPitch, yDiff, (width >> 2) + 1);
+
+			for (int x = 0; x < width; x += 8) {
+				__m128i r, g, b;
+				convertChroma(interpolate410Row(uColumns + (x >> 2)), interpolate410Row(vColumns + (x >> 2)), r, g, b);
+
+				if (x + 8 <= width) {
+					convertPixels(dst + chunk + x, ySrc + chunk + x, r, g, b, format);
+				} else {
+					// The width is a multiple of four, so there are four
+					// pixels left
+					PixelInt rest[8];
+					byte luma[8] = { 0 };
+					memcpy(luma, ySrc + chunk + x, 4);
+					convertPixels(rest, luma, r, g, b, format);
+					memcpy(dst + chunk + x, rest, 4 * sizeof(PixelInt));
+				}
+			}
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+	}
+}
+
+#endif
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -236,6 +532,17 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_SSE2_YUV
+	const SSE2PixelFormat sse2Format(dst->format, scale);
+	if (sse2Format.supported) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV444ToRGBSSE2<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, sse2Format, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGBSSE2<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, sse2Format, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
@@ -274,7 +581,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -292,6 +599,16 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_SSE2_YUV
+	// At 32bpp the lookup tables are faster here, since they share one
+	// chroma lookup across four pixels.
+	const SSE2PixelFormat sse2Format(dst->format, scale);
+	if (sse2Format.supported && dst->format.bytesPerPixel == 2) {
+		convertYUV420ToRGBSSE2<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, sse2Format, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
@@ -377,6 +694,17 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_SSE2_YUV
+	const SSE2PixelFormat sse2Format(dst->format, scale);
+	if (sse2Format.supported) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV410ToRGBSSE2<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, sse2Format, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV410ToRGBSSE2<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, sse2Format, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
+#endif
+
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
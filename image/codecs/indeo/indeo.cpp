@@ -565,15 +565,15 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 
 	if (_ctx._isScalable) {
 		if (_ctx._isIndeo4)
-			recomposeHaar(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
+			IndeoDSP::ffIviRecomposeHaar(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
 		else
-			recompose53(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
+			IndeoDSP::ffIviRecompose53(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
 	} else {
-		outputPlane(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
+		IndeoDSP::ffIviOutputPlane(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
 	}
 
-	outputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1]);
-	outputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2]);
+	IndeoDSP::ffIviOutputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1]);
+	IndeoDSP::ffIviOutputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2]);
 
 	// If the bidirectional mode is enabled, next I and the following P
 	// frame will be sent together. Unfortunately the approach below seems
@@ -715,216 +715,6 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 	return result;
 }
 
-void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
-		uint8 *dst, const int dstPitch) {
-
-	// all bands should have the same _pitch
-	int32 pitch = _plane->_bands[0]._pitch;
-
-	// get pointers to the wavelet bands
-	const short *b0Ptr = _plane->_bands[0]._buf;
-	const short *b1Ptr = _plane->_bands[1]._buf;
-	const short *b2Ptr = _plane->_bands[2]._buf;
-	const short *b3Ptr = _plane->_bands[3]._buf;
-
-	for (int y = 0; y < _plane->_height; y += 2) {
-		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
-			// load coefficients
-			int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
-			int b1 = b1Ptr[indx]; //should be: b1 = (_numBands > 1) ? b1Ptr[indx] : 0;
-			int b2 = b2Ptr[indx]; //should be: b2 = (_numBands > 2) ? b2Ptr[indx] : 0;
-			int b3 = b3Ptr[indx]; //should be: b3 = (_numBands > 3) ? b3Ptr[indx] : 0;
-
-							   // haar wavelet recomposition
-			int p0 = (b0 + b1 + b2 + b3 + 2) >> 2;
-			int p1 = (b0 + b1 - b2 - b3 + 2) >> 2;
-			int p2 = (b0 - b1 + b2 - b3 + 2) >> 2;
-			int p3 = (b0 - b1 - b2 + b3 + 2) >> 2;
-
-			// bias, convert and output four pixels
-			dst[x] = avClipUint8(p0 + 128);
-			dst[x + 1] = avClipUint8(p1 + 128);
-			dst[dstPitch + x] = avClipUint8(p2 + 128);
-			dst[dstPitch + x + 1] = avClipUint8(p3 + 128);
-		}// for x
-
-		dst += dstPitch << 1;
-
-		b0Ptr += pitch;
-		b1Ptr += pitch;
-		b2Ptr += pitch;
-		b3Ptr += pitch;
-	}// for y
-}
-
-void IndeoDecoderBase::recompose53(const IVIPlaneDesc *_plane,
-		uint8 *dst, const int dstPitch) {
-	int32 p0, p1, p2, p3, tmp0, tmp1, tmp2;
-	int32 b0_1, b0_2, b1_1, b1_2, b1_3, b2_1, b2_2, b2_3, b2_4, b2_5, b2_6;
-	int32 b3_1, b3_2, b3_3, b3_4, b3_5, b3_6, b3_7, b3_8, b3_9;
-	const int numBands = 4;
-
-	// all bands should have the same _pitch
-	int32 pitch_ = _plane->_bands[0]._pitch;
-
-	// pixels at the position "y-1" will be set to pixels at the "y" for the 1st iteration
-	int32 back_pitch = 0;
-
-	// get pointers to the wavelet bands
-	const short *b0Ptr = _plane->_bands[0]._buf;
-	const short *b1Ptr = _plane->_bands[1]._buf;
-	const short *b2Ptr = _plane->_bands[2]._buf;
-	const short *b3Ptr = _plane->_bands[3]._buf;
-
-	for (int y = 0; y < _plane->_height; y += 2) {
-
-		if (y + 2 >= _plane->_height)
-			pitch_ = 0;
-		// load storage variables with values
-		if (numBands > 0) {
-			b0_1 = b0Ptr[0];
-			b0_2 = b0Ptr[pitch_];
-		}
-
-		if (numBands > 1) {
-			b1_1 = b1Ptr[back_pitch];
-			b1_2 = b1Ptr[0];
-			b1_3 = b1_1 - b1_2 * 6 + b1Ptr[pitch_];
-		}
-
-		if (numBands > 2) {
-			b2_2 = b2Ptr[0];		// b2[x,  y  ]
-			b2_3 = b2_2;			// b2[x+1,y  ] = b2[x,y]
-			b2_5 = b2Ptr[pitch_];	// b2[x  ,y+1]
-			b2_6 = b2_5;			// b2[x+1,y+1] = b2[x,y+1]
-		}
-
-		if (numBands > 3) {
-			b3_2 = b3Ptr[back_pitch];	// b3[x  ,y-1]
-			b3_3 = b3_2;				// b3[x+1,y-1] = b3[x  ,y-1]
-			b3_5 = b3Ptr[0];			// b3[x  ,y  ]
-			b3_6 = b3_5;				// b3[x+1,y  ] = b3[x  ,y  ]
-			b3_8 = b3_2 - b3_5 * 6 + b3Ptr[pitch_];
-			b3_9 = b3_8;
-		}
-
-		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
-			if (x + 2 >= _plane->_width) {
-				b0Ptr--;
-				b1Ptr--;
-				b2Ptr--;
-				b3Ptr--;
-			}
-
-			// some values calculated in the previous iterations can
-			// be reused in the next ones, so do appropriate copying
-			b2_1 = b2_2; // b2[x-1,y  ] = b2[x,  y  ]
-			b2_2 = b2_3; // b2[x  ,y  ] = b2[x+1,y  ]
-			b2_4 = b2_5; // b2[x-1,y+1] = b2[x  ,y+1]
-			b2_5 = b2_6; // b2[x  ,y+1] = b2[x+1,y+1]
-			b3_1 = b3_2; // b3[x-1,y-1] = b3[x  ,y-1]
-			b3_2 = b3_3; // b3[x  ,y-1] = b3[x+1,y-1]
-			b3_4 = b3_5; // b3[x-1,y  ] = b3[x  ,y  ]
-			b3_5 = b3_6; // b3[x  ,y  ] = b3[x+1,y  ]
-			b3_7 = b3_8; // vert_HPF(x-1)
-			b3_8 = b3_9; // vert_HPF(x  )
-
-			p0 = p1 = p2 = p3 = 0;
-
-			// process the LL-band by applying LPF both vertically and horizontally
-			if (numBands > 0) {
-				tmp0 = b0_1;
-				tmp2 = b0_2;
-				b0_1 = b0Ptr[indx + 1];
-				b0_2 = b0Ptr[pitch_ + indx + 1];
-				tmp1 = tmp0 + b0_1;
-
-				p0 = tmp0 << 4;
-				p1 = tmp1 << 3;
-				p2 = (tmp0 + tmp2) << 3;
-				p3 = (tmp1 + tmp2 + b0_2) << 2;
-			}
-
-			// process the HL-band by applying HPF vertically and LPF horizontally
-			if (numBands > 1) {
-				tmp0 = b1_2;
-				tmp1 = b1_1;
-				b1_2 = b1Ptr[indx + 1];
-				b1_1 = b1Ptr[back_pitch + indx + 1];
-
-				tmp2 = tmp1 - tmp0 * 6 + b1_3;
-				b1_3 = b1_1 - b1_2 * 6 + b1Ptr[pitch_ + indx + 1];
-
-				p0 += (tmp0 + tmp1) << 3;
-				p1 += (tmp0 + tmp1 + b1_1 + b1_2) << 2;
-				p2 += tmp2 << 2;
-				p3 += (tmp2 + b1_3) << 1;
-			}
-
-			// process the LH-band by applying LPF vertically and HPF horizontally
-			if (numBands > 2) {
-				b2_3 = b2Ptr[indx + 1];
-				b2_6 = b2Ptr[pitch_ + indx + 1];
-
-				tmp0 = b2_1 + b2_2;
-				tmp1 = b2_1 - b2_2 * 6 + b2_3;
-
-				p0 += tmp0 << 3;
-				p1 += tmp1 << 2;
-				p2 += (tmp0 + b2_4 + b2_5) << 2;
-				p3 += (tmp1 + b2_4 - b2_5 * 6 + b2_6) << 1;
-			}
-
-			// process the HH-band by applying HPF both vertically and horizontally
-			if (numBands > 3) {
-				b3_6 = b3Ptr[indx + 1];            // b3[x+1,y  ]
-				b3_3 = b3Ptr[back_pitch + indx + 1]; // b3[x+1,y-1]
-
-				tmp0 = b3_1 + b3_4;
-				tmp1 = b3_2 + b3_5;
-				tmp2 = b3_3 + b3_6;
-
-				b3_9 = b3_3 - b3_6 * 6 + b3Ptr[pitch_ + indx + 1];
-
-				p0 += (tmp0 + tmp1) << 2;
-				p1 += (tmp0 - tmp1 * 6 + tmp2) << 1;
-				p2 += (b3_7 + b3_8) << 1;
-				p3 += b3_7 - b3_8 * 6 + b3_9;
-			}
-
-			// output four pixels
-			dst[x] = avClipUint8((p0 >> 6) + 128);
-			dst[x + 1] = avClipUint8((p1 >> 6) + 128);
-			dst[dstPitch + x] = avClipUint8((p2 >> 6) + 128);
-			dst[dstPitch + x + 1] = avClipUint8((p3 >> 6) + 128);
-		}// for x
-
-		dst += dstPitch << 1;
-
-		back_pitch = -pitch_;
-
-		b0Ptr += pitch_ + 1;
-		b1Ptr += pitch_ + 1;
-		b2Ptr += pitch_ + 1;
-		b3Ptr += pitch_ + 1;
-	}
-}
-
-void IndeoDecoderBase::outputPlane(IVIPlaneDesc *_plane, uint8 *dst, int dstPitch) {
-	const int16 *src = _plane->_bands[0]._buf;
-	uint32 pitch = _plane->_bands[0]._pitch;
-
-	if (!src)
-		return;
-
-	for (int y = 0; y < _plane->_height; y++) {
-		for (int x = 0; x < _plane->_width; x++)
-			dst[x] = avClipUint8(src[x] + 128);
-		src += pitch;
-		dst += dstPitch;
-	}
-}
-
 int IndeoDecoderBase::processEmptyTile(IVIBandDesc *band,
 			IVITile *tile, int32 mvScale) {
 	if (tile->_numMBs != IVI_MBs_PER_TILE(tile->_width, tile->_height, band->_mbSize)) {
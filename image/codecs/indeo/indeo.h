@@ -441,35 +441,6 @@ private:
 	 */
 	int decode_band(IVIBandDesc *band);
 
-	/**
-	 *  Haar wavelet recomposition filter for Indeo 4
-	 *
-	 *  @param[in]  plane		Pointer to the descriptor of the plane being processed
-	 *  @param[out] dst			pointer to the destination buffer
-	 *  @param[in]  dstPitch	Pitch of the destination buffer
-	 */
-	void recomposeHaar(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch);
-
-	/**
-	 *  5/3 wavelet recomposition filter for Indeo5
-	 *
-	 *  @param[in]   plane        Pointer to the descriptor of the plane being processed
-	 *  @param[out]  dst          Pointer to the destination buffer
-	 *  @param[in]   dstPitch     Pitch of the destination buffer
-	 */
-	void recompose53(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch);
-
-	/*
-	 *  Convert and output the current plane.
-	 *  This conversion is done by adding back the bias value of 128
-	 *  (subtracted in the encoder) and clipping the result.
-	 *
-	 *  @param[in]   plane		Pointer to the descriptor of the plane being processed
-	 *  @param[out]  dst		Pointer to the buffer receiving converted pixels
-	 *  @param[in]   dstPitch	Pitch for moving to the next y line
-	 */
-	void outputPlane(IVIPlaneDesc *plane, uint8 *dst, int dstPitch);
-
 	/**
 	 *  Handle empty tiles by performing data copying and motion
 	 *  compensation respectively.
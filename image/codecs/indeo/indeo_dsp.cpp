@@ -27,6 +27,12 @@
  */
 
 #include "image/codecs/indeo/indeo_dsp.h"
+#include "common/util.h"
+
+#if defined(__SSE2__)
+#define USE_SSE2_INDEO
+#include <emmintrin.h>
+#endif
 
 namespace Image {
 namespace Indeo {
@@ -602,5 +608,450 @@ IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+#ifdef USE_SSE2_INDEO
+
+/** Sign extend the lower or upper four coefficients to 32 bits. */
+static inline __m128i widenLow(__m128i x) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+}
+
+static inline __m128i widenHigh(__m128i x) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+}
+
+/**
+ * Interleave two rows of eight recomposed values, add the bias and clip
+ * them to sixteen pixels. The values are computed in 32 bits; saturating
+ * them to 16 bits first does not change the clipped result.
+ */
+static inline __m128i outputPixels16(__m128i evenLow, __m128i evenHigh, __m128i oddLow, __m128i oddHigh) {
+	const __m128i bias = _mm_set1_epi16(128);
+	const __m128i even = _mm_packs_epi32(evenLow, evenHigh);
+	const __m128i odd = _mm_packs_epi32(oddLow, oddHigh);
+
+	return _mm_packus_epi16(_mm_adds_epi16(_mm_unpacklo_epi16(even, odd), bias),
+	                        _mm_adds_epi16(_mm_unpackhi_epi16(even, odd), bias));
+}
+
+/**
+ * Haar recomposition of four coefficients of each band, giving the
+ * unbiased pixels p0 to p3 of four 2x2 blocks.
+ */
+static inline void recomposeHaar4(__m128i b0, __m128i b1, __m128i b2, __m128i b3,
+		__m128i &p0, __m128i &p1, __m128i &p2, __m128i &p3) {
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128i sum01 = _mm_add_epi32(_mm_add_epi32(b0, b1), two);
+	const __m128i diff01 = _mm_add_epi32(_mm_sub_epi32(b0, b1), two);
+	const __m128i sum23 = _mm_add_epi32(b2, b3);
+	const __m128i diff23 = _mm_sub_epi32(b2, b3);
+
+	p0 = _mm_srai_epi32(_mm_add_epi32(sum01, sum23), 2);
+	p1 = _mm_srai_epi32(_mm_sub_epi32(sum01, sum23), 2);
+	p2 = _mm_srai_epi32(_mm_add_epi32(diff01, diff23), 2);
+	p3 = _mm_srai_epi32(_mm_sub_epi32(diff01, diff23), 2);
+}
+
+/** Recompose eight coefficients of each band to 16x2 pixels. */
+static inline void recomposeHaar8(const int16 *b0Ptr, const int16 *b1Ptr, const int16 *b2Ptr, const int16 *b3Ptr,
+		uint8 *dst, int dstPitch) {
+	const __m128i b0 = _mm_loadu_si128((const __m128i *)b0Ptr);
+	const __m128i b1 = _mm_loadu_si128((const __m128i *)b1Ptr);
+	const __m128i b2 = _mm_loadu_si128((const __m128i *)b2Ptr);
+	const __m128i b3 = _mm_loadu_si128((const __m128i *)b3Ptr);
+
+	__m128i p0Low, p1Low, p2Low, p3Low, p0High, p1High, p2High, p3High;
+	recomposeHaar4(widenLow(b0), widenLow(b1), widenLow(b2), widenLow(b3), p0Low, p1Low, p2Low, p3Low);
+	recomposeHaar4(widenHigh(b0), widenHigh(b1), widenHigh(b2), widenHigh(b3), p0High, p1High, p2High, p3High);
+
+	_mm_storeu_si128((__m128i *)dst, outputPixels16(p0Low, p0High, p1Low, p1High));
+	_mm_storeu_si128((__m128i *)(dst + dstPitch), outputPixels16(p2Low, p2High, p3Low, p3High));
+}
+
+/**
+ * 5/3 recomposition of the 2x2 block at column i of the current row, with
+ * the neighboring columns l and r and the neighboring rows of each band
+ * repeated at the edges. This is the per block form of ffIviRecompose53.
+ */
+static inline void recompose53Block(const int16 *const *prev, const int16 *const *cur, const int16 *const *next,
+		int i, int l, int r, uint8 *dst, int dstPitch) {
+	// process the LL-band by applying LPF both vertically and horizontally
+	const int32 ll = cur[0][i] + cur[0][r];
+	int32 p0 = cur[0][i] << 4;
+	int32 p1 = ll << 3;
+	int32 p2 = (cur[0][i] + next[0][i]) << 3;
+	int32 p3 = (ll + next[0][i] + next[0][r]) << 2;
+
+	// process the HL-band by applying HPF vertically and LPF horizontally
+	const int32 hl = prev[1][i] - cur[1][i] * 6;
+	const int32 hlVert = hl + hl + next[1][i];
+	const int32 hlVertRight = prev[1][r] - cur[1][r] * 6 + next[1][r];
+	p0 += (cur[1][i] + prev[1][i]) << 3;
+	p1 += (cur[1][i] + prev[1][i] + prev[1][r] + cur[1][r]) << 2;
+	p2 += hlVert << 2;
+	p3 += (hlVert + hlVertRight) << 1;
+
+	// process the LH-band by applying LPF vertically and HPF horizontally
+	const int32 lh0 = cur[2][l] + cur[2][i];
+	const int32 lh1 = cur[2][l] - cur[2][i] * 6 + cur[2][r];
+	p0 += lh0 << 3;
+	p1 += lh1 << 2;
+	p2 += (lh0 + next[2][l] + next[2][i]) << 2;
+	p3 += (lh1 + next[2][l] - next[2][i] * 6 + next[2][r]) << 1;
+
+	// process the HH-band by applying HPF both vertically and horizontally
+	const int32 hh0 = prev[3][l] + cur[3][l];
+	const int32 hh1 = prev[3][i] + cur[3][i];
+	const int32 hh2 = prev[3][r] + cur[3][r];
+	const int32 hhVertLeft = prev[3][l] - cur[3][l] * 6 + next[3][l];
+	const int32 hhVert = prev[3][i] - cur[3][i] * 6 + next[3][i];
+	const int32 hhVertRight = prev[3][r] - cur[3][r] * 6 + next[3][r];
+	p0 += (hh0 + hh1) << 2;
+	p1 += (hh0 - hh1 * 6 + hh2) << 1;
+	p2 += (hhVertLeft + hhVert) << 1;
+	p3 += hhVertLeft - hhVert * 6 + hhVertRight;
+
+	// output four pixels
+	dst[2 * i] = avClipUint8((p0 >> 6) + 128);
+	dst[2 * i + 1] = avClipUint8((p1 >> 6) + 128);
+	dst[dstPitch + 2 * i] = avClipUint8((p2 >> 6) + 128);
+	dst[dstPitch + 2 * i + 1] = avClipUint8((p3 >> 6) + 128);
+}
+
+/** Load four coefficients, sign extended to 32 bits. */
+static inline __m128i load4(const int16 *src) {
+	const __m128i x = _mm_loadl_epi64((const __m128i *)src);
+	return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+}
+
+static inline __m128i times6(__m128i x) {
+	return _mm_add_epi32(_mm_slli_epi32(x, 2), _mm_slli_epi32(x, 1));
+}
+
+/**
+ * recompose53Block for the four blocks starting at column i, which must
+ * not touch the left or right edge. The results are not yet shifted.
+ */
+static inline void recompose53Block4(const int16 *const *prev, const int16 *const *cur, const int16 *const *next,
+		int i, __m128i &p0, __m128i &p1, __m128i &p2, __m128i &p3) {
+	// LL-band
+	const __m128i c0 = load4(cur[0] + i), c0Right = load4(cur[0] + i + 1);
+	const __m128i n0 = load4(next[0] + i), n0Right = load4(next[0] + i + 1);
+	const __m128i ll = _mm_add_epi32(c0, c0Right);
+	p0 = _mm_slli_epi32(c0, 4);
+	p1 = _mm_slli_epi32(ll, 3);
+	p2 = _mm_slli_epi32(_mm_add_epi32(c0, n0), 3);
+	p3 = _mm_slli_epi32(_mm_add_epi32(ll, _mm_add_epi32(n0, n0Right)), 2);
+
+	// HL-band
+	const __m128i p1Cur = load4(prev[1] + i), p1Right = load4(prev[1] + i + 1);
+	const __m128i c1 = load4(cur[1] + i), c1Right = load4(cur[1] + i + 1);
+	const __m128i hl = _mm_sub_epi32(p1Cur, times6(c1));
+	const __m128i hlVert = _mm_add_epi32(_mm_add_epi32(hl, hl), load4(next[1] + i));
+	const __m128i hlVertRight = _mm_add_epi32(_mm_sub_epi32(p1Right, times6(c1Right)), load4(next[1] + i + 1));
+	const __m128i hlSum = _mm_add_epi32(c1, p1Cur);
+	p0 = _mm_add_epi32(p0, _mm_slli_epi32(hlSum, 3));
+	p1 = _mm_add_epi32(p1, _mm_slli_epi32(_mm_add_epi32(hlSum, _mm_add_epi32(p1Right, c1Right)), 2));
+	p2 = _mm_add_epi32(p2, _mm_slli_epi32(hlVert, 2));
+	p3 = _mm_add_epi32(p3, _mm_slli_epi32(_mm_add_epi32(hlVert, hlVertRight), 1));
+
+	// LH-band
+	const __m128i c2Left = load4(cur[2] + i - 1), c2 = load4(cur[2] + i), c2Right = load4(cur[2] + i + 1);
+	const __m128i n2Left = load4(next[2] + i - 1), n2 = load4(next[2] + i), n2Right = load4(next[2] + i + 1);
+	const __m128i lh0 = _mm_add_epi32(c2Left, c2);
+	const __m128i lh1 = _mm_add_epi32(_mm_sub_epi32(c2Left, times6(c2)), c2Right);
+	p0 = _mm_add_epi32(p0, _mm_slli_epi32(lh0, 3));
+	p1 = _mm_add_epi32(p1, _mm_slli_epi32(lh1, 2));
+	p2 = _mm_add_epi32(p2, _mm_slli_epi32(_mm_add_epi32(lh0, _mm_add_epi32(n2Left, n2)), 2));
+	p3 = _mm_add_epi32(p3, _mm_slli_epi32(_mm_add_epi32(_mm_add_epi32(lh1, n2Left), _mm_sub_epi32(n2Right, times6(n2))), 1));
+
+	// HH-band
+	const __m128i p3Left = load4(prev[3] + i - 1), p3Cur = load4(prev[3] + i), p3Right = load4(prev[3] + i + 1);
+	const __m128i c3Left = load4(cur[3] + i - 1), c3 = load4(cur[3] + i), c3Right = load4(cur[3] + i + 1);
+	const __m128i hh0 = _mm_add_epi32(p3Left, c3Left);
+	const __m128i hh1 = _mm_add_epi32(p3Cur, c3);
+	const __m128i hh2 = _mm_add_epi32(p3Right, c3Right);
+	const __m128i hhVertLeft = _mm_add_epi32(_mm_sub_epi32(p3Left, times6(c3Left)), load4(next[3] + i - 1));
+	const __m128i hhVert = _mm_add_epi32(_mm_sub_epi32(p3Cur, times6(c3)), load4(next[3] + i));
+	const __m128i hhVertRight = _mm_add_epi32(_mm_sub_epi32(p3Right, times6(c3Right)), load4(next[3] + i + 1));
+	p0 = _mm_add_epi32(p0, _mm_slli_epi32(_mm_add_epi32(hh0, hh1), 2));
+	p1 = _mm_add_epi32(p1, _mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(hh0, times6(hh1)), hh2), 1));
+	p2 = _mm_add_epi32(p2, _mm_slli_epi32(_mm_add_epi32(hhVertLeft, hhVert), 1));
+	p3 = _mm_add_epi32(p3, _mm_add_epi32(_mm_sub_epi32(hhVertLeft, times6(hhVert)), hhVertRight));
+}
+
+/**
+ * ffIviRecompose53, computing eight blocks at once away from the left and
+ * right edges.
+ */
+static void recompose53SSE2(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch) {
+	// all bands should have the same pitch
+	const int32 pitch = plane->_bands[0]._pitch;
+	const int numBlocks = (plane->_width + 1) >> 1;
+	const int numRows = (plane->_height + 1) >> 1;
+
+	for (int row = 0; row < numRows; row++) {
+		const int16 *prev[4], *cur[4], *next[4];
+		for (int b = 0; b < 4; b++) {
+			cur[b] = plane->_bands[b]._buf + row * pitch;
+			prev[b] = (row > 0) ? cur[b] - pitch : cur[b];
+			next[b] = (row + 1 < numRows) ? cur[b] + pitch : cur[b];
+		}
+
+		recompose53Block(prev, cur, next, 0, 0, MIN(1, numBlocks - 1), dst, dstPitch);
+
+		int i = 1;
+		for (; i + 9 <= numBlocks; i += 8) {
+			__m128i p0Low, p1Low, p2Low, p3Low, p0High, p1High, p2High, p3High;
+			recompose53Block4(prev, cur, next, i, p0Low, p1Low, p2Low, p3Low);
+			recompose53Block4(prev, cur, next, i + 4, p0High, p1High, p2High, p3High);
+
+			_mm_storeu_si128((__m128i *)(dst + 2 * i), outputPixels16(
+				_mm_srai_epi32(p0Low, 6), _mm_srai_epi32(p0High, 6), _mm_srai_epi32(p1Low, 6), _mm_srai_epi32(p1High, 6)));
+			_mm_storeu_si128((__m128i *)(dst + dstPitch + 2 * i), outputPixels16(
+				_mm_srai_epi32(p2Low, 6), _mm_srai_epi32(p2High, 6), _mm_srai_epi32(p3Low, 6), _mm_srai_epi32(p3High, 6)));
+		}
+
+		for (; i < numBlocks; i++)
+			recompose53Block(prev, cur, next, i, i - 1, MIN(i + 1, numBlocks - 1), dst, dstPitch);
+
+		dst += dstPitch << 1;
+	}
+}
+
+#endif
+
+void IndeoDSP::ffIviRecomposeHaar(const IVIPlaneDesc *_plane,
+		uint8 *dst, const int dstPitch) {
+
+	// all bands should have the same _pitch
+	int32 pitch = _plane->_bands[0]._pitch;
+
+	// get pointers to the wavelet bands
+	const short *b0Ptr = _plane->_bands[0]._buf;
+	const short *b1Ptr = _plane->_bands[1]._buf;
+	const short *b2Ptr = _plane->_bands[2]._buf;
+	const short *b3Ptr = _plane->_bands[3]._buf;
+
+	for (int y = 0; y < _plane->_height; y += 2) {
+		int x = 0, indx = 0;
+
+#ifdef USE_SSE2_INDEO
+		for (; x + 16 <= _plane->_width; x += 16, indx += 8)
+			recomposeHaar8(b0Ptr + indx, b1Ptr + indx, b2Ptr + indx, b3Ptr + indx, dst + x, dstPitch);
+#endif
+
+		for (; x < _plane->_width; x += 2, indx++) {
+			// load coefficients
+			int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
+			int b1 = b1Ptr[indx]; //should be: b1 = (_numBands > 1) ? b1Ptr[indx] : 0;
+			int b2 = b2Ptr[indx]; //should be: b2 = (_numBands > 2) ? b2Ptr[indx] : 0;
+			int b3 = b3Ptr[indx]; //should be: b3 = (_numBands > 3) ? b3Ptr[indx] : 0;
+
+							   // haar wavelet recomposition
+			int p0 = (b0 + b1 + b2 + b3 + 2) >> 2;
+			int p1 = (b0 + b1 - b2 - b3 + 2) >> 2;
+			int p2 = (b0 - b1 + b2 - b3 + 2) >> 2;
+			int p3 = (b0 - b1 - b2 + b3 + 2) >> 2;
+
+			// bias, convert and output four pixels
+			dst[x] = avClipUint8(p0 + 128);
+			dst[x + 1] = avClipUint8(p1 + 128);
+			dst[dstPitch + x] = avClipUint8(p2 + 128);
+			dst[dstPitch + x + 1] = avClipUint8(p3 + 128);
+		}// for x
+
+		dst += dstPitch << 1;
+
+		b0Ptr += pitch;
+		b1Ptr += pitch;
+		b2Ptr += pitch;
+		b3Ptr += pitch;
+	}// for y
+}
+
+void IndeoDSP::ffIviRecompose53(const IVIPlaneDesc *_plane,
+		uint8 *dst, const int dstPitch) {
+#ifdef USE_SSE2_INDEO
+	recompose53SSE2(_plane, dst, dstPitch);
+#else
+	int32 p0, p1, p2, p3, tmp0, tmp1, tmp2;
+	int32 b0_1, b0_2, b1_1, b1_2, b1_3, b2_1, b2_2, b2_3, b2_4, b2_5, b2_6;
+	int32 b3_1, b3_2, b3_3, b3_4, b3_5, b3_6, b3_7, b3_8, b3_9;
+	const int numBands = 4;
+
+	// all bands should have the same _pitch
+	int32 pitch_ = _plane->_bands[0]._pitch;
+
+	// pixels at the position "y-1" will be set to pixels at the "y" for the 1st iteration
+	int32 back_pitch = 0;
+
+	// get pointers to the wavelet bands
+	const short *b0Ptr = _plane->_bands[0]._buf;
+	const short *b1Ptr = _plane->_bands[1]._buf;
+	const short *b2Ptr = _plane->_bands[2]._buf;
+	const short *b3Ptr = _plane->_bands[3]._buf;
+
+	for (int y = 0; y < _plane->_height; y += 2) {
+
+		if (y + 2 >= _plane->_height)
+			pitch_ = 0;
+		// load storage variables with values
+		if (numBands > 0) {
+			b0_1 = b0Ptr[0];
+			b0_2 = b0Ptr[pitch_];
+		}
+
+		if (numBands > 1) {
+			b1_1 = b1Ptr[back_pitch];
+			b1_2 = b1Ptr[0];
+			b1_3 = b1_1 - b1_2 * 6 + b1Ptr[pitch_];
+		}
+
+		if (numBands > 2) {
+			b2_2 = b2Ptr[0];		// b2[x,  y  ]
+			b2_3 = b2_2;			// b2[x+1,y  ] = b2[x,y]
+			b2_5 = b2Ptr[pitch_];	// b2[x  ,y+1]
+			b2_6 = b2_5;			// b2[x+1,y+1] = b2[x,y+1]
+		}
+
+		if (numBands > 3) {
+			b3_2 = b3Ptr[back_pitch];	// b3[x  ,y-1]
+			b3_3 = b3_2;				// b3[x+1,y-1] = b3[x  ,y-1]
+			b3_5 = b3Ptr[0];			// b3[x  ,y  ]
+			b3_6 = b3_5;				// b3[x+1,y  ] = b3[x  ,y  ]
+			b3_8 = b3_2 - b3_5 * 6 + b3Ptr[pitch_];
+			b3_9 = b3_8;
+		}
+
+		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
+			if (x + 2 >= _plane->_width) {
+				b0Ptr--;
+				b1Ptr--;
+				b2Ptr--;
+				b3Ptr--;
+			}
+
+			// some values calculated in the previous iterations can
+			// be reused in the next ones, so do appropriate copying
+			b2_1 = b2_2; // b2[x-1,y  ] = b2[x,  y  ]
+			b2_2 = b2_3; // b2[x  ,y  ] = b2[x+1,y  ]
+			b2_4 = b2_5; // b2[x-1,y+1] = b2[x  ,y+1]
+			b2_5 = b2_6; // b2[x  ,y+1] = b2[x+1,y+1]
+			b3_1 = b3_2; // b3[x-1,y-1] = b3[x  ,y-1]
+			b3_2 = b3_3; // b3[x  ,y-1] = b3[x+1,y-1]
+			b3_4 = b3_5; // b3[x-1,y  ] = b3[x  ,y  ]
+			b3_5 = b3_6; // b3[x  ,y  ] = b3[x+1,y  ]
+			b3_7 = b3_8; // vert_HPF(x-1)
+			b3_8 = b3_9; // vert_HPF(x  )
+
+			p0 = p1 = p2 = p3 = 0;
+
+			// process the LL-band by applying LPF both vertically and horizontally
+			if (numBands > 0) {
+				tmp0 = b0_1;
+				tmp2 = b0_2;
+				b0_1 = b0Ptr[indx + 1];
+				b0_2 = b0Ptr[pitch_ + indx + 1];
+				tmp1 = tmp0 + b0_1;
+
+				p0 = tmp0 << 4;
+				p1 = tmp1 << 3;
+				p2 = (tmp0 + tmp2) << 3;
+				p3 = (tmp1 + tmp2 + b0_2) << 2;
+			}
+
+			// process the HL-band by applying HPF vertically and LPF horizontally
+			if (numBands > 1) {
+				tmp0 = b1_2;
+				tmp1 = b1_1;
+				b1_2 = b1Ptr[indx + 1];
+				b1_1 = b1Ptr[back_pitch + indx + 1];
+
+				tmp2 = tmp1 - tmp0 * 6 + b1_3;
+				b1_3 = b1_1 - b1_2 * 6 + b1Ptr[pitch_ + indx + 1];
+
+				p0 += (tmp0 + tmp1) << 3;
+				p1 += (tmp0 + tmp1 + b1_1 + b1_2) << 2;
+				p2 += tmp2 << 2;
+				p3 += (tmp2 + b1_3) << 1;
+			}
+
+			// process the LH-band by applying LPF vertically and HPF horizontally
+			if (numBands > 2) {
+				b2_3 = b2Ptr[indx + 1];
+				b2_6 = b2Ptr[pitch_ + indx + 1];
+
+				tmp0 = b2_1 + b2_2;
+				tmp1 = b2_1 - b2_2 * 6 + b2_3;
+
+				p0 += tmp0 << 3;
+				p1 += tmp1 << 2;
+				p2 += (tmp0 + b2_4 + b2_5) << 2;
+				p3 += (tmp1 + b2_4 - b2_5 * 6 + b2_6) << 1;
+			}
+
+			// process the HH-band by applying HPF both vertically and horizontally
+			if (numBands > 3) {
+				b3_6 = b3Ptr[indx + 1];            // b3[x+1,y  ]
+				b3_3 = b3Ptr[back_pitch + indx + 1]; // b3[x+1,y-1]
+
+				tmp0 = b3_1 + b3_4;
+				tmp1 = b3_2 + b3_5;
+				tmp2 = b3_3 + b3_6;
+
+				b3_9 = b3_3 - b3_6 * 6 + b3Ptr[pitch_ + indx + 1];
+
+				p0 += (tmp0 + tmp1) << 2;
+				p1 += (tmp0 - tmp1 * 6 + tmp2) << 1;
+				p2 += (b3_7 + b3_8) << 1;
+				p3 += b3_7 - b3_8 * 6 + b3_9;
+			}
+
+			// output four pixels
+			dst[x] = avClipUint8((p0 >> 6) + 128);
+			dst[x + 1] = avClipUint8((p1 >> 6) + 128);
+			dst[dstPitch + x] = avClipUint8((p2 >> 6) + 128);
+			dst[dstPitch + x + 1] = avClipUint8((p3 >> 6) + 128);
+		}// for x
+
+		dst += dstPitch << 1;
+
+		back_pitch = -pitch_;
+
+		b0Ptr += pitch_ + 1;
+		b1Ptr += pitch_ + 1;
+		b2Ptr += pitch_ + 1;
+		b3Ptr += pitch_ + 1;
+	}
+#endif
+}
+
+void IndeoDSP::ffIviOutputPlane(const IVIPlaneDesc *_plane, uint8 *dst, int dstPitch) {
+	const int16 *src = _plane->_bands[0]._buf;
+	uint32 pitch = _plane->_bands[0]._pitch;
+
+	if (!src)
+		return;
+
+	for (int y = 0; y < _plane->_height; y++) {
+		int x = 0;
+
+#ifdef USE_SSE2_INDEO
+		// Saturating adds, so that the bias cannot wrap around
+		const __m128i bias = _mm_set1_epi16(128);
+		for (; x + 16 <= _plane->_width; x += 16) {
+			const __m128i lo = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(src + x)), bias);
+			const __m128i hi = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(src + x + 8)), bias);
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+		}
+#endif
+
+		for (; x < _plane->_width; x++)
+			dst[x] = avClipUint8(src[x] + 128);
+		src += pitch;
+		dst += dstPitch;
+	}
+}
+
 } // End of namespace Indeo
 } // End of namespace Image
@@ -30,6 +30,8 @@
 #include "common/endian.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -175,6 +177,15 @@ void outputMessage(j_common_ptr cinfo) {
 #endif
 
 bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	return loadStreamInternal(stream, nullptr);
+}
+
+bool JPEGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	assert(dst.getPixels());
+	return loadStreamInternal(stream, &dst);
+}
+
+bool JPEGDecoder::loadStreamInternal(Common::SeekableReadStream &stream, Graphics::Surface *target) {
 #ifdef USE_JPEG
 	// Reset member variables from previous decodings
 	destroy();
@@ -210,62 +221,104 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
-	// Allocate buffers for the output data
+	// The scanlines as libjpeg outputs them
+#ifdef SCUMM_BIG_ENDIAN
+	const Graphics::PixelFormat decodedFormat(3, 8, 8, 8, 0, 16, 8, 0, 0);
+#else
+	const Graphics::PixelFormat decodedFormat(3, 8, 8, 8, 0, 0, 8, 16, 0);
+#endif
+	// We use RGBA8888 by default
+	const Graphics::PixelFormat rgbaFormat(4, 8, 8, 8, 0, 24, 16, 8, 0);
+
+	Graphics::PixelFormat format;
 	switch (_colorSpace) {
 	case kColorSpaceRGBA:
-		// We use RGBA8888 in this scenario
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0));
+		format = target ? target->format : _outputFormat.bytesPerPixel ? _outputFormat : rgbaFormat;
 		break;
 
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		format = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	}
 
+	if ((target && target->format.bytesPerPixel != format.bytesPerPixel) ||
+	    (_colorSpace == kColorSpaceRGBA && format.bytesPerPixel != 2 && format.bytesPerPixel != 4)) {
+		warning("Cannot decode JPEG image to pixel format %s", (target ? target->format : format).toString().c_str());
+		jpeg_destroy_decompress(&cinfo);
+		return false;
+	}
+
+	// Only the part of the image within the clip rect is output, and only
+	// as much of it as fits into the target surface
+	Common::Rect area(cinfo.output_width, cinfo.output_height);
+	if (!_clipRect.isEmpty())
+		area.clip(_clipRect);
+	if (target) {
+		area.setWidth(MIN<int>(area.width(), target->w));
+		area.setHeight(MIN<int>(area.height(), target->h));
+	}
+
+	// Allocate buffers for the output data
+	Graphics::Surface *dstSurface = target;
+	if (!dstSurface) {
+		_surface.create(area.width(), area.height(), format);
+		dstSurface = &_surface;
+	}
+
 	// Allocate buffer for one scanline
 	assert(cinfo.output_components == 3);
 	JDIMENSION pitch = cinfo.output_width * cinfo.output_components;
-	assert(_surface.pitch >= pitch);
 	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
 
-	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
-
+	// Go through the image data scanline by scanline. Scanlines below the
+	// area are not decoded at all.
+	while (cinfo.output_scanline < (JDIMENSION)area.bottom) {
+		const int y = cinfo.output_scanline;
 		jpeg_read_scanlines(&cinfo, buffer, 1);
+		if (y < area.top)
+			continue;
+
+		byte *dst = (byte *)dstSurface->getBasePtr(0, y - area.top);
+		const byte *src = buffer[0] + area.left * cinfo.output_components;
 
-		const byte *src = buffer[0];
 		switch (_colorSpace) {
-		case kColorSpaceRGBA: {
-			for (int remaining = cinfo.output_width; remaining > 0; --remaining) {
-				byte r = *src++;
-				byte g = *src++;
-				byte b = *src++;
-				// We need to insert a alpha value of 255 (opaque) here.
+		case kColorSpaceRGBA:
+			if (format == rgbaFormat) {
+				for (int remaining = area.width(); remaining > 0; --remaining) {
+					byte r = *src++;
+					byte g = *src++;
+					byte b = *src++;
+					// We need to insert a alpha value of 255 (opaque) here.
 #ifdef SCUMM_BIG_ENDIAN
-				*dst++ = r;
-				*dst++ = g;
-				*dst++ = b;
-				*dst++ = 0xFF;
+					*dst++ = r;
+					*dst++ = g;
+					*dst++ = b;
+					*dst++ = 0xFF;
 #else
-				*dst++ = 0xFF;
-				*dst++ = b;
-				*dst++ = g;
-				*dst++ = r;
+					*dst++ = 0xFF;
+					*dst++ = b;
+					*dst++ = g;
+					*dst++ = r;
 #endif
+				}
+			} else {
+				Graphics::crossBlit(dst, src, area.width() * format.bytesPerPixel, area.width() * decodedFormat.bytesPerPixel,
+				                    area.width(), 1, format, decodedFormat);
 			}
-			} break;
+			break;
 
 		case kColorSpaceYUV:
-			memcpy(dst, src, pitch);
+			memcpy(dst, src, area.width() * cinfo.output_components);
 			break;
 		}
 	}
 
-	// We are done with decompressing, thus free all the data
-	jpeg_finish_decompress(&cinfo);
+	// We are done with decompressing, thus free all the data. Stopping
+	// early needs no finishing, destroying aborts the decompression.
+	if (cinfo.output_scanline == cinfo.output_height)
+		jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
 	return true;
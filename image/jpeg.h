@@ -33,6 +33,7 @@
 #ifndef IMAGE_JPEG_H
 #define IMAGE_JPEG_H
 
+#include "common/rect.h"
 #include "graphics/surface.h"
 #include "image/image_decoder.h"
 #include "image/codecs/codec.h"
@@ -92,9 +93,47 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Request the pixel format of the decoded surface. Scanlines are
+	 * converted as they are decoded, so no surface in another format is
+	 * allocated. Any 2 or 4 byte format can be used.
+	 *
+	 * This only applies to the RGBA color space, which defaults to RGBA8888.
+	 *
+	 * @param format The pixel format to output.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputFormat = format; }
+
+	/**
+	 * Only decode the given area of the image. The decoded surface has the
+	 * size of the area clipped to the image. Scanlines below the area are
+	 * not decoded at all.
+	 *
+	 * An empty rect, the default, selects the whole image.
+	 *
+	 * @param rect The area to decode.
+	 */
+	void setClipRect(const Common::Rect &rect) { _clipRect = rect; }
+
+	/**
+	 * Decode the image straight into the top left corner of an existing
+	 * surface, in the pixel format of that surface. Parts of the image
+	 * which do not fit into the surface are not decoded. Afterwards,
+	 * getSurface() returns an empty surface.
+	 *
+	 * @param stream The input stream.
+	 * @param dst    The surface receiving the image.
+	 * @return Whether loading the file succeeded.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
+
 private:
+	bool loadStreamInternal(Common::SeekableReadStream &stream, Graphics::Surface *target);
+
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
+	Graphics::PixelFormat _outputFormat;
+	Common::Rect _clipRect;
 };
 
 } // End of namespace Image
@@ -31,11 +31,13 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
 #include "common/array.h"
 #include "common/stream.h"
+#include "common/util.h"
 
 namespace Image {
 
@@ -54,6 +56,7 @@ void PNGDecoder::destroy() {
 	}
 	delete[] _palette;
 	_palette = NULL;
+	_paletteColorCount = 0;
 }
 
 #ifdef USE_PNG
@@ -96,6 +99,43 @@ void pngFlushStream(png_structp pngPtr) {
  */
 
 bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	return loadStreamInternal(stream, nullptr);
+}
+
+bool PNGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst) {
+	assert(dst.getPixels());
+	return loadStreamInternal(stream, &dst);
+}
+
+#ifdef USE_PNG
+namespace {
+
+/**
+ * Convert a decoded row to the output format. Paletted rows are converted
+ * through colorMap, unless the output is paletted as well.
+ */
+void convertRow(byte *dst, const Graphics::PixelFormat &dstFormat, const byte *src, const Graphics::PixelFormat &srcFormat,
+		uint width, const uint32 *colorMap) {
+	if (dstFormat == srcFormat) {
+		memcpy(dst, src, width * dstFormat.bytesPerPixel);
+	} else if (srcFormat.bytesPerPixel == 1) {
+		if (dstFormat.bytesPerPixel == 2) {
+			for (uint x = 0; x < width; x++)
+				((uint16 *)dst)[x] = colorMap[src[x]];
+		} else {
+			for (uint x = 0; x < width; x++)
+				((uint32 *)dst)[x] = colorMap[src[x]];
+		}
+	} else {
+		Graphics::crossBlit(dst, src, width * dstFormat.bytesPerPixel, width * srcFormat.bytesPerPixel,
+		                    width, 1, dstFormat, srcFormat);
+	}
+}
+
+} // End of anonymous namespace
+#endif
+
+bool PNGDecoder::loadStreamInternal(Common::SeekableReadStream &stream, Graphics::Surface *target) {
 #ifdef USE_PNG
 	destroy();
 
@@ -146,18 +186,15 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
-
 	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
 	// will be transformed into ARGB images
+	Graphics::PixelFormat decodedFormat;
 	if (colorType == PNG_COLOR_TYPE_PALETTE && !png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS)) {
 		int numPalette = 0;
 		png_colorp palette = NULL;
 		uint32 success = png_get_PLTE(pngPtr, infoPtr, &palette, &numPalette);
 		if (success != PNG_INFO_PLTE) {
-			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			png_destroy_read_struct(&pngPtr, &infoPtr, &endInfo);
 			return false;
 		}
 		_paletteColorCount = numPalette;
@@ -168,7 +205,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			_palette[(i * 3) + 2] = palette[i].blue;
 
 		}
-		_outputSurface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+		decodedFormat = Graphics::PixelFormat::createFormatCLUT8();
 		png_set_packing(pngPtr);
 	} else {
 		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
@@ -176,11 +213,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			isAlpha = true;
 			png_set_expand(pngPtr);
 		}
-		_outputSurface->create(width, height, Graphics::PixelFormat(4,
-		                       8, 8, 8, isAlpha ? 8 : 0, 24, 16, 8, 0));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
+		decodedFormat = Graphics::PixelFormat(4, 8, 8, 8, isAlpha ? 8 : 0, 24, 16, 8, 0);
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -202,6 +235,43 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 	}
 
+	// Only the part of the image within the clip rect is output, and only
+	// as much of it as fits into the target surface
+	Common::Rect area(width, height);
+	if (!_clipRect.isEmpty())
+		area.clip(_clipRect);
+	if (target) {
+		area.setWidth(MIN<int>(area.width(), target->w));
+		area.setHeight(MIN<int>(area.height(), target->h));
+	}
+
+	const Graphics::PixelFormat format = target ? target->format :
+	                                     _outputFormat.bytesPerPixel ? _outputFormat : decodedFormat;
+	if (format != decodedFormat && format.bytesPerPixel != 2 && format.bytesPerPixel != 4) {
+		warning("Cannot decode PNG image to pixel format %s", format.toString().c_str());
+		png_destroy_read_struct(&pngPtr, &infoPtr, &endInfo);
+		return false;
+	}
+
+	// Allocate memory for the final image data.
+	// To keep memory framentation low this happens before allocating memory for temporary image data.
+	Graphics::Surface *dst = target;
+	if (!dst) {
+		dst = _outputSurface = new Graphics::Surface();
+		_outputSurface->create(area.width(), area.height(), format);
+		if (area.width() && area.height() && !_outputSurface->getPixels()) {
+			error("Could not allocate memory for output image.");
+		}
+	}
+
+	uint32 colorMap[256];
+	if (decodedFormat.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
+		for (int i = 0; i < 256; i++) {
+			colorMap[i] = (i < _paletteColorCount) ?
+			              format.RGBToColor(_palette[i * 3], _palette[i * 3 + 1], _palette[i * 3 + 2]) : 0;
+		}
+	}
+
 	// After the transformations have been registered, the image data is read again.
 	png_set_interlace_handling(pngPtr);
 	png_read_update_info(pngPtr, infoPtr);
@@ -209,14 +279,29 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
+	// Whole rows in the output format can be decoded in place
+	const uint32 rowSize = width * decodedFormat.bytesPerPixel;
+	const bool inPlace = (format == decodedFormat && area.width() == width);
+	byte *rowBuffer = new byte[rowSize];
+
 	if (interlaceType == PNG_INTERLACE_NONE) {
-		// PNGs without interlacing can simply be read row by row.
-		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
+		// PNGs without interlacing can simply be read row by row. Rows
+		// below the area are not decoded at all.
+		for (int i = 0; i < area.bottom; i++) {
+			if (inPlace && i >= area.top) {
+				png_read_row(pngPtr, (png_bytep)dst->getBasePtr(0, i - area.top), NULL);
+			} else {
+				png_read_row(pngPtr, rowBuffer, NULL);
+				if (i >= area.top)
+					convertRow((byte *)dst->getBasePtr(0, i - area.top), format,
+					           rowBuffer + area.left * decodedFormat.bytesPerPixel, decodedFormat, area.width(), colorMap);
+			}
 		}
 	} else {
 		// PNGs with interlacing require us to allocate an auxillary
-		// buffer with pointers to all row starts.
+		// buffer with pointers to all row starts. All passes have to be
+		// decoded, but rows outside the area share a single buffer.
+		byte *areaBuffer = inPlace ? nullptr : new byte[rowSize * area.height()];
 
 		// Allocate row pointer buffer
 		png_bytep *rowPtr = new png_bytep[height];
@@ -225,18 +310,34 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		}
 
 		// Initialize row pointers
-		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+		for (int i = 0; i < height; i++) {
+			if (i < area.top || i >= area.bottom)
+				rowPtr[i] = rowBuffer;
+			else if (inPlace)
+				rowPtr[i] = (png_bytep)dst->getBasePtr(0, i - area.top);
+			else
+				rowPtr[i] = areaBuffer + (i - area.top) * rowSize;
+		}
 
 		// Read image data
 		png_read_image(pngPtr, rowPtr);
 
+		if (!inPlace) {
+			for (int i = 0; i < area.height(); i++)
+				convertRow((byte *)dst->getBasePtr(0, i), format,
+				           areaBuffer + i * rowSize + area.left * decodedFormat.bytesPerPixel, decodedFormat, area.width(), colorMap);
+		}
+
 		// Free row pointer buffer
 		delete[] rowPtr;
+		delete[] areaBuffer;
 	}
 
-	// Read additional data at the end.
-	png_read_end(pngPtr, NULL);
+	delete[] rowBuffer;
+
+	// Read additional data at the end, unless decoding stopped early.
+	if (interlaceType != PNG_INTERLACE_NONE || area.bottom == height)
+		png_read_end(pngPtr, NULL);
 
 	// Destroy libpng structures
 	png_destroy_read_struct(&pngPtr, &infoPtr, &endInfo);
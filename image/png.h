@@ -32,7 +32,9 @@
 #define IMAGE_PNG_H
 
 #include "common/scummsys.h"
+#include "common/rect.h"
 #include "common/textconsole.h"
+#include "graphics/pixelformat.h"
 #include "image/image_decoder.h"
 
 namespace Common {
@@ -57,7 +59,39 @@ public:
 	const byte *getPalette() const { return _palette; }
 	uint16 getPaletteColorCount() const { return _paletteColorCount; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
+
+	/**
+	 * Decode the image straight into the top left corner of an existing
+	 * surface, in the pixel format of that surface. Parts of the image
+	 * which do not fit into the surface are not decoded. Afterwards,
+	 * getSurface() returns 0, but the palette is still available.
+	 *
+	 * @param stream the input stream
+	 * @param dst the surface receiving the image
+	 * @return whether loading the file succeeded
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst);
+
+	/**
+	 * Request the pixel format of the decoded surface. Rows are converted
+	 * as they are decoded, so no surface in another format is allocated.
+	 *
+	 * By default, paletted images are decoded to CLUT8 and all others to
+	 * 32 bit ARGB. Paletted images can be output in any 2 or 4 byte format.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputFormat = format; }
+
+	/**
+	 * Only decode the given area of the image. The decoded surface has the
+	 * size of the area clipped to the image. Rows below the area are not
+	 * decoded at all, unless the image is interlaced.
+	 *
+	 * An empty rect, the default, selects the whole image.
+	 */
+	void setClipRect(const Common::Rect &rect) { _clipRect = rect; }
 private:
+	bool loadStreamInternal(Common::SeekableReadStream &stream, Graphics::Surface *target);
+
 	byte *_palette;
 	uint16 _paletteColorCount;
 
@@ -65,6 +99,9 @@ private:
 	bool _skipSignature;
 
 	Graphics::Surface *_outputSurface;
+
+	Graphics::PixelFormat _outputFormat;
+	Common::Rect _clipRect;
 };
 
 /**
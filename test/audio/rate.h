@@ -0,0 +1,156 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/decoders/raw.h"
+
+#include "common/endian.h"
+#include "common/memstream.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kFracBits = 15,
+		kFracOne = 1 << kFracBits,
+		kFracHalf = 1 << (kFracBits - 1)
+	};
+
+	uint32 _seed;
+
+	int16 nextSample() {
+		_seed = _seed * 1103515245 + 12345;
+		return (int16)(_seed >> 16);
+	}
+
+	/** Create a stream of random (full scale) samples, and return a copy of them in samples. */
+	Audio::AudioStream *createRandomStream(int rate, bool stereo, int numFrames, int16 *&samples) {
+		const int numSamples = numFrames * (stereo ? 2 : 1);
+		samples = new int16[numSamples];
+		byte *data = (byte *)malloc(numSamples * 2);
+		for (int i = 0; i < numSamples; ++i) {
+			samples[i] = nextSample();
+			WRITE_LE_UINT16(data + i * 2, samples[i]);
+		}
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, numSamples * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(stream, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (stereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	static void referenceAdd(int16 &dst, int sample, int vol) {
+		const int val = dst + (sample * vol) / Audio::Mixer::kMaxMixerVolume;
+		dst = (int16)CLIP<int>(val, -32768, 32767);
+	}
+
+	/**
+	 * Plain, frame by frame reimplementation of the linear interpolating
+	 * converter. If inRate equals outRate, this is the same as copying.
+	 */
+	static int referenceFlow(const int16 *in, int inFrames, int inRate, int outRate, bool stereo, bool reverseStereo,
+	                         int16 *out, int outFrames, int volL, int volR) {
+		const int32 oposInc = (inRate << kFracBits) / outRate;
+		int32 opos = kFracOne;
+		int inPos = 0;
+		int last0 = 0, last1 = 0, cur0 = 0, cur1 = 0;
+
+		for (int i = 0; i < outFrames; ++i) {
+			int out0, out1;
+			if (inRate == outRate) {
+				if (inPos == inFrames)
+					return i;
+				out0 = in[inPos * (stereo ? 2 : 1)];
+				out1 = stereo ? in[inPos * 2 + 1] : out0;
+				++inPos;
+			} else {
+				while (opos >= kFracOne) {
+					if (inPos == inFrames)
+						return i;
+					last0 = cur0;
+					last1 = cur1;
+					cur0 = in[inPos * (stereo ? 2 : 1)];
+					cur1 = stereo ? in[inPos * 2 + 1] : 0;
+					++inPos;
+					opos -= kFracOne;
+				}
+
+				out0 = (int16)(last0 + (((cur0 - last0) * opos + kFracHalf) >> kFracBits));
+				out1 = stereo ? (int16)(last1 + (((cur1 - last1) * opos + kFracHalf) >> kFracBits)) : out0;
+				opos += oposInc;
+			}
+
+			referenceAdd(out[i * 2 + (reverseStereo ? 1 : 0)], out0, volL);
+			referenceAdd(out[i * 2 + (reverseStereo ? 0 : 1)], out1, volR);
+		}
+		return outFrames;
+	}
+
+	void flowTestTemplate(int inRate, int outRate, bool stereo, bool reverseStereo, int volL, int volR) {
+		const int inFrames = 3000;
+		// Ask for more output than the input provides, so that the end of
+		// the stream is handled, too.
+		const int outFrames = inFrames * outRate / inRate + 100;
+
+		_seed = inRate ^ (outRate << 8) ^ (stereo << 1) ^ reverseStereo;
+
+		int16 *samples;
+		Audio::AudioStream *stream = createRandomStream(inRate, stereo, inFrames, samples);
+
+		// Start with random output, so that clamping is tested.
+		int16 *expected = new int16[outFrames * 2];
+		int16 *result = new int16[outFrames * 2];
+		for (int i = 0; i < outFrames * 2; ++i)
+			expected[i] = result[i] = nextSample();
+
+		const int expectedFrames = referenceFlow(samples, inFrames, inRate, outRate, stereo, reverseStereo, expected, outFrames, volL, volR);
+
+		// Convert in oddly sized chunks, like the mixer would.
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, reverseStereo);
+		int resultFrames = 0;
+		while (resultFrames < outFrames) {
+			const int chunk = MIN(outFrames - resultFrames, 333);
+			const int frames = converter->flow(*stream, result + resultFrames * 2, chunk, volL, volR);
+			resultFrames += frames;
+			if (frames < chunk)
+				break;
+		}
+
+		TS_ASSERT_EQUALS(resultFrames, expectedFrames);
+		TS_ASSERT_EQUALS(memcmp(result, expected, outFrames * 2 * sizeof(int16)), 0);
+
+		delete converter;
+		delete stream;
+		delete[] samples;
+		delete[] expected;
+		delete[] result;
+	}
+
+public:
+	void test_copy_mono() {
+		flowTestTemplate(22050, 22050, false, false, 256, 100);
+	}
+
+	void test_copy_stereo() {
+		flowTestTemplate(44100, 44100, true, false, 37, 256);
+	}
+
+	void test_copy_stereo_reversed() {
+		flowTestTemplate(44100, 44100, true, true, 255, 3);
+	}
+
+	void test_linear_mono() {
+		flowTestTemplate(11025, 44100, false, false, 256, 256);
+	}
+
+	void test_linear_stereo() {
+		flowTestTemplate(22050, 48000, true, false, 200, 17);
+	}
+
+	void test_linear_stereo_reversed() {
+		flowTestTemplate(32000, 44100, true, true, 128, 255);
+	}
+
+	void test_linear_downsampling() {
+		flowTestTemplate(48000, 44100, true, false, 256, 0);
+	}
+};
@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+
+#include "common/util.h"
+
+#include <string.h>
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kSourceSamples = 16 * 1024,
+	kOutputFrames = 2048,
+	kOutputRate = 44100
+};
+
+/** Endless audio stream, looping over a buffer of random samples. */
+class LoopingStream : public Audio::AudioStream {
+public:
+	LoopingStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _pos(0) {
+		Random rnd;
+		for (int i = 0; i < kSourceSamples; ++i)
+			_samples[i] = (int16)rnd.next();
+	}
+
+	virtual int readBuffer(int16 *buffer, const int numSamples) {
+		int left = numSamples;
+		while (left > 0) {
+			const int len = MIN<int>(left, kSourceSamples - _pos);
+			memcpy(buffer, _samples + _pos, len * sizeof(int16));
+			buffer += len;
+			left -= len;
+			_pos = (_pos + len) % kSourceSamples;
+		}
+		return numSamples;
+	}
+
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+	virtual bool endOfData() const { return false; }
+
+private:
+	const int _rate;
+	const bool _stereo;
+	int _pos;
+	int16 _samples[kSourceSamples];
+};
+
+/** Mix one mixer callback's worth of audio from a single channel. */
+struct RateFlow {
+	LoopingStream _stream;
+	Audio::RateConverter *_converter;
+	int16 _output[kOutputFrames * 2];
+
+	RateFlow(int rate, bool stereo, bool reverseStereo) : _stream(rate, stereo) {
+		_converter = Audio::makeRateConverter(rate, kOutputRate, stereo, reverseStereo);
+	}
+
+	~RateFlow() {
+		delete _converter;
+	}
+
+	void operator()() {
+		memset(_output, 0, sizeof(_output));
+		g_sink += _converter->flow(_stream, _output, kOutputFrames, 200, 150);
+	}
+};
+
+} // End of anonymous namespace
+
+void runAudioBenchmarks(Runner &runner) {
+	RateFlow copyMono(kOutputRate, false, false);
+	runner.run("rateconverter", "copy_mono", kOutputFrames, copyMono);
+	RateFlow copyStereo(kOutputRate, true, false);
+	runner.run("rateconverter", "copy_stereo", kOutputFrames, copyStereo);
+	RateFlow copyStereoReversed(kOutputRate, true, true);
+	runner.run("rateconverter", "copy_stereo_reversed", kOutputFrames, copyStereoReversed);
+
+	RateFlow linearMono(22050, false, false);
+	runner.run("rateconverter", "linear_mono", kOutputFrames, linearMono);
+	RateFlow linearStereo(22050, true, false);
+	runner.run("rateconverter", "linear_stereo", kOutputFrames, linearStereo);
+	RateFlow linearDownsample(48000, true, false);
+	runner.run("rateconverter", "linear_stereo_downsample", kOutputFrames, linearDownsample);
+
+	RateFlow simpleStereo(88200, true, false);
+	runner.run("rateconverter", "simple_stereo", kOutputFrames, simpleStereo);
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,191 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TEST_BENCHMARK_BENCHMARK_H
+#define TEST_BENCHMARK_BENCHMARK_H
+
+// The benchmarks are a host tool: they time with the system clock and
+// write their results to stdout.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+#include <stdio.h>
+#include <time.h>
+
+namespace Benchmark {
+
+/**
+ * Sink for benchmark results. Every benchmark should fold the values it
+ * computes into this, so that the compiler cannot optimize the measured
+ * code away.
+ */
+extern volatile uint32 g_sink;
+
+/**
+ * Simple xorshift random number generator. In contrast to
+ * Common::RandomSource it needs no OSystem, and it always starts from
+ * the same seed, so every run of the benchmarks works on identical input.
+ */
+class Random {
+public:
+	explicit Random(uint32 seed = 0x2545F491) : _state(seed ? seed : 1) {}
+
+	uint32 next() {
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	/** Return a random number in the range [0, max). */
+	uint32 next(uint32 max) {
+		return next() % max;
+	}
+
+	void fill(byte *dst, uint32 size) {
+		for (uint32 i = 0; i < size; ++i)
+			dst[i] = (byte)(next() >> 24);
+	}
+
+private:
+	uint32 _state;
+};
+
+/**
+ * Kinds of synthetic game resources, used as input for the decompression
+ * benchmarks.
+ */
+enum ResourceKind {
+	kResourceScript,	///< byte code and text with many repeated tokens
+	kResourceBitmap,	///< palettized image with runs and similar rows
+	kResourceAudio,		///< 8-bit PCM audio, which hardly compresses
+	kResourceKindCount
+};
+
+/**
+ * Fill dst with size bytes of synthetic resource data of the given kind.
+ */
+void generateResource(ResourceKind kind, byte *dst, uint32 size, Random &rnd);
+
+/**
+ * Return a monotonic timestamp in nanoseconds.
+ */
+inline uint64 getNanoseconds() {
+#if defined(POSIX) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000000ULL + (uint64)ts.tv_nsec;
+#else
+	return (uint64)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+/**
+ * Runs benchmarks and prints their results.
+ *
+ * A benchmark is any object with an "operator()()" which performs one
+ * round of the measured work, processing a fixed number of items (e.g.
+ * lookups or bytes) each time. The runner calls it repeatedly until
+ * enough time has passed for a stable measurement, and reports the time
+ * taken per item.
+ *
+ * Results are written to stdout as comma separated values, one line per
+ * benchmark:
+ *
+ *   group,name,items,iterations,ns_per_item,items_per_second
+ */
+class Runner {
+public:
+	Runner(int argc, char **argv);
+
+	/**
+	 * Measure the given benchmark, unless it is excluded by the filter
+	 * given on the command line.
+	 *
+	 * @param group   group of the benchmark, e.g. "hashmap"
+	 * @param name    name of the benchmark within its group
+	 * @param items   number of items processed by one call of func
+	 * @param func    the benchmark to run
+	 */
+	template<class Func>
+	void run(const char *group, const char *name, uint32 items, Func &func) {
+		if (!isEnabled(group, name))
+			return;
+
+		// Warm up caches and find out how many calls we need to fill
+		// the minimal measurement time.
+		uint32 iterations = 1;
+		for (;;) {
+			const uint64 start = getNanoseconds();
+			for (uint32 i = 0; i < iterations; ++i)
+				func();
+			const uint64 elapsed = getNanoseconds() - start;
+			if (elapsed >= _minTime / 4 || iterations >= (1U << 30))
+				break;
+			iterations *= 2;
+		}
+		iterations *= 4;
+
+		// Take the best of several runs to filter out scheduling noise.
+		uint64 best = (uint64)-1;
+		for (int rep = 0; rep < _repetitions; ++rep) {
+			const uint64 start = getNanoseconds();
+			for (uint32 i = 0; i < iterations; ++i)
+				func();
+			const uint64 elapsed = getNanoseconds() - start;
+			if (elapsed < best)
+				best = elapsed;
+		}
+
+		report(group, name, items, iterations, best);
+	}
+
+private:
+	bool isEnabled(const char *group, const char *name) const;
+	void report(const char *group, const char *name, uint32 items, uint32 iterations, uint64 elapsed);
+
+	Common::String _filter;
+	uint64 _minTime;
+	int _repetitions;
+};
+
+// Benchmark groups, see the respective source files.
+void runContainerBenchmarks(Runner &runner);
+void runStreamBenchmarks(Runner &runner);
+void runCompressionBenchmarks(Runner &runner);
+void runAudioBenchmarks(Runner &runner);
+void runGraphicsBenchmarks(Runner &runner);
+void runBlitBenchmarks(Runner &runner);
+void runYUVBenchmarks(Runner &runner);
+void runImageBenchmarks(Runner &runner);
+#ifdef USE_BINK
+void runVideoBenchmarks(Runner &runner);
+#endif
+#ifdef BENCHMARK_SCI
+void runSciBenchmarks(Runner &runner);
+#endif
+
+} // End of namespace Benchmark
+
+#endif
@@ -0,0 +1,173 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "test/benchmark/benchmark.h"
+#include "test/common/encoders.h"
+
+#include "common/array.h"
+#include "common/dcl.h"
+#include "common/memstream.h"
+
+#include <math.h>
+
+namespace Benchmark {
+
+void generateResource(ResourceKind kind, byte *dst, uint32 size, Random &rnd) {
+	switch (kind) {
+	case kResourceScript: {
+		static const char *const words[] = {
+			"pushi", "send", "self", "ego", "room", "client", "cycles", "state",
+			"You can't do that.", "Nothing happens.", "The door is locked.", " "
+		};
+		uint32 pos = 0;
+		while (pos < size) {
+			if (rnd.next(3) == 0) {
+				// Opcode with operands
+				dst[pos++] = rnd.next(0x80);
+				if (pos < size)
+					dst[pos++] = rnd.next(16);
+			} else {
+				const char *word = words[rnd.next(ARRAYSIZE(words))];
+				while (*word && pos < size)
+					dst[pos++] = *word++;
+			}
+		}
+		break;
+	}
+
+	case kResourceBitmap: {
+		const uint32 width = 320;
+		for (uint32 pos = 0; pos < size; ) {
+			if (pos >= width && rnd.next(4) != 0) {
+				// Same as the row above, except for a few pixels
+				for (uint32 x = 0; x < width && pos < size; ++x, ++pos)
+					dst[pos] = rnd.next(32) ? dst[pos - width] : rnd.next(256);
+			} else {
+				for (uint32 x = 0; x < width && pos < size; ) {
+					const byte color = rnd.next(16) + (rnd.next(2) ? 0 : 0x40);
+					for (uint32 run = rnd.next(24) + 1; run && x < width && pos < size; --run, ++x)
+						dst[pos++] = color;
+				}
+			}
+		}
+		break;
+	}
+
+	case kResourceAudio: {
+		double phase = 0.0;
+		for (uint32 pos = 0; pos < size; ++pos) {
+			phase += 0.05 + (pos % 4096) * 0.00002;
+			dst[pos] = (byte)(128 + 80 * sin(phase) + (int)rnd.next(9) - 4);
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+namespace {
+
+enum {
+	kNumResources = 24
+};
+
+/**
+ * A set of DCL compressed resources of all kinds and with sizes from 2 KiB
+ * to 64 KiB.
+ */
+struct DCLCorpus {
+	Common::Array<byte> _packed[kNumResources];
+	uint32 _unpackedSize[kNumResources];
+	uint32 _totalSize;
+	byte *_target;
+
+	DCLCorpus() : _totalSize(0) {
+		Random rnd;
+		uint32 maxSize = 0;
+		for (int i = 0; i < kNumResources; ++i) {
+			const uint32 size = 2048 << (i % 6);
+			Common::Array<byte> data;
+			data.resize(size);
+			generateResource((ResourceKind)(i % kResourceKindCount), data.begin(), size, rnd);
+			TestEncoders::encodeDCL(data.begin(), size, 6, _packed[i]);
+
+			_unpackedSize[i] = size;
+			_totalSize += size;
+			maxSize = MAX(maxSize, size);
+		}
+		_target = new byte[maxSize];
+	}
+
+	~DCLCorpus() {
+		delete[] _target;
+	}
+};
+
+struct DCLDecompressBuffer {
+	DCLCorpus &_corpus;
+	explicit DCLDecompressBuffer(DCLCorpus &corpus) : _corpus(corpus) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (int i = 0; i < kNumResources; ++i) {
+			Common::MemoryReadStream src(_corpus._packed[i].begin(), _corpus._packed[i].size());
+			Common::decompressDCL(&src, _corpus._target, _corpus._packed[i].size(), _corpus._unpackedSize[i]);
+			sum += _corpus._target[i];
+		}
+		g_sink += sum;
+	}
+};
+
+struct DCLDecompressStream {
+	DCLCorpus &_corpus;
+	explicit DCLDecompressStream(DCLCorpus &corpus) : _corpus(corpus) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (int i = 0; i < kNumResources; ++i) {
+			Common::MemoryReadStream src(_corpus._packed[i].begin(), _corpus._packed[i].size());
+			Common::SeekableReadStream *unpacked = Common::decompressDCL(&src, _corpus._packed[i].size(), _corpus._unpackedSize[i]);
+			sum += unpacked->readByte();
+			delete unpacked;
+		}
+		g_sink += sum;
+	}
+};
+
+} // End of anonymous namespace
+
+void runCompressionBenchmarks(Runner &runner) {
+	DCLCorpus *dclCorpus = new DCLCorpus();
+
+	// Bytes of unpacked data per second
+	DCLDecompressBuffer dclDecompressBuffer(*dclCorpus);
+	runner.run("dcl", "decompress_to_buffer", dclCorpus->_totalSize, dclDecompressBuffer);
+	DCLDecompressStream dclDecompressStream(*dclCorpus);
+	runner.run("dcl", "decompress_to_stream", dclCorpus->_totalSize, dclDecompressStream);
+
+	delete dclCorpus;
+}
+
+} // End of namespace Benchmark
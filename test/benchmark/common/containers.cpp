@@ -0,0 +1,316 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/array.h"
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kNumKeys = 1000
+};
+
+/** Generate kNumKeys distinct integer keys, and as many keys not among them. */
+void makeIntKeys(Common::Array<int> &keys, Common::Array<int> &missing) {
+	Random rnd;
+	for (int i = 0; i < kNumKeys; ++i) {
+		// Odd keys are present, even ones are missing
+		const int key = (int)(rnd.next() & 0x3FFFFFFF);
+		keys.push_back(key | 1);
+		missing.push_back(key & ~1);
+	}
+}
+
+/** Generate kNumKeys distinct resource-like file names. */
+void makeStringKeys(Common::Array<Common::String> &keys, Common::Array<Common::String> &missing) {
+	Random rnd;
+	for (int i = 0; i < kNumKeys; ++i) {
+		const uint32 num = rnd.next(100000);
+		keys.push_back(Common::String::format("data/room%d/sprite%05u.png", i, num));
+		missing.push_back(Common::String::format("data/room%d/sound%05u.wav", i, num));
+	}
+}
+
+template<class Map, class KeyType>
+struct MapInsert {
+	const Common::Array<KeyType> &_keys;
+	explicit MapInsert(const Common::Array<KeyType> &keys) : _keys(keys) {}
+
+	void operator()() {
+		Map map;
+		for (uint i = 0; i < _keys.size(); ++i)
+			map[_keys[i]] = i;
+		g_sink += map.size();
+	}
+};
+
+template<class Map, class KeyType>
+struct MapLookup {
+	Map _map;
+	const Common::Array<KeyType> &_queries;
+
+	MapLookup(const Common::Array<KeyType> &keys, const Common::Array<KeyType> &queries) : _queries(queries) {
+		for (uint i = 0; i < keys.size(); ++i)
+			_map[keys[i]] = i;
+	}
+
+	void operator()() {
+		const Map &map = _map;
+		uint32 sum = 0;
+		for (uint i = 0; i < _queries.size(); ++i)
+			sum += map.getVal(_queries[i], 0);
+		g_sink += sum;
+	}
+};
+
+template<class Map, class KeyType>
+struct MapIterate {
+	Map _map;
+
+	explicit MapIterate(const Common::Array<KeyType> &keys) {
+		for (uint i = 0; i < keys.size(); ++i)
+			_map[keys[i]] = i;
+	}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (typename Map::const_iterator i = _map.begin(); i != _map.end(); ++i)
+			sum += i->_value;
+		g_sink += sum;
+	}
+};
+
+template<class Map, class KeyType>
+struct MapChurn {
+	Map _map;
+	const Common::Array<KeyType> &_keys;
+	uint _pos;
+
+	explicit MapChurn(const Common::Array<KeyType> &keys) : _keys(keys), _pos(0) {
+		for (uint i = 0; i < keys.size() / 2; ++i)
+			_map[keys[i]] = i;
+	}
+
+	void operator()() {
+		// Keep the map half full, replacing the oldest key each time.
+		const uint n = _keys.size();
+		for (uint i = 0; i < n; ++i) {
+			_map.erase(_keys[_pos]);
+			_map[_keys[(_pos + n / 2) % n]] = i;
+			_pos = (_pos + 1) % n;
+		}
+		g_sink += _map.size();
+	}
+};
+
+template<class Map, class KeyType>
+void runMapBenchmarks(Runner &runner, const char *group, const Common::Array<KeyType> &keys, const Common::Array<KeyType> &missing) {
+	MapInsert<Map, KeyType> insert(keys);
+	runner.run(group, "insert", keys.size(), insert);
+
+	MapLookup<Map, KeyType> lookupHit(keys, keys);
+	runner.run(group, "lookup_hit", keys.size(), lookupHit);
+
+	MapLookup<Map, KeyType> lookupMiss(keys, missing);
+	runner.run(group, "lookup_miss", missing.size(), lookupMiss);
+
+	MapIterate<Map, KeyType> iterate(keys);
+	runner.run(group, "iterate", keys.size(), iterate);
+
+	MapChurn<Map, KeyType> churn(keys);
+	runner.run(group, "erase_insert", keys.size(), churn);
+}
+
+struct ArrayPushBack {
+	void operator()() {
+		Common::Array<uint32> array;
+		for (uint32 i = 0; i < kNumKeys; ++i)
+			array.push_back(i);
+		g_sink += array.size();
+	}
+};
+
+struct ArrayIterate {
+	Common::Array<uint32> _array;
+
+	ArrayIterate() {
+		Random rnd;
+		for (uint32 i = 0; i < kNumKeys; ++i)
+			_array.push_back(rnd.next());
+	}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (Common::Array<uint32>::const_iterator i = _array.begin(); i != _array.end(); ++i)
+			sum += *i;
+		g_sink += sum;
+	}
+};
+
+struct ListPushBack {
+	void operator()() {
+		Common::List<uint32> list;
+		for (uint32 i = 0; i < kNumKeys; ++i)
+			list.push_back(i);
+		g_sink += list.size();
+	}
+};
+
+struct ListIterate {
+	Common::List<uint32> _list;
+
+	ListIterate() {
+		Random rnd;
+		for (uint32 i = 0; i < kNumKeys; ++i)
+			_list.push_back(rnd.next());
+	}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (Common::List<uint32>::const_iterator i = _list.begin(); i != _list.end(); ++i)
+			sum += *i;
+		g_sink += sum;
+	}
+};
+
+/**
+ * String benchmarks are run once on strings short enough for the builtin
+ * storage of Common::String, and once on strings which need external
+ * storage.
+ */
+struct StringCopy {
+	Common::Array<Common::String> _strings;
+
+	explicit StringCopy(uint length) {
+		Random rnd;
+		for (int i = 0; i < kNumKeys; ++i) {
+			Common::String str;
+			for (uint j = 0; j < length; ++j)
+				str += (char)('a' + rnd.next(26));
+			_strings.push_back(str);
+		}
+	}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (uint i = 0; i < _strings.size(); ++i) {
+			Common::String copy(_strings[i]);
+			sum += copy.size();
+		}
+		g_sink += sum;
+	}
+};
+
+struct StringAppend {
+	const uint _length;
+
+	explicit StringAppend(uint length) : _length(length) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (int i = 0; i < kNumKeys / 10; ++i) {
+			Common::String str;
+			for (uint j = 0; j < _length; ++j)
+				str += (char)('a' + (j & 15));
+			sum += str.size();
+		}
+		g_sink += sum;
+	}
+};
+
+struct StringCompare : public StringCopy {
+	explicit StringCompare(uint length) : StringCopy(length) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (uint i = 1; i < _strings.size(); ++i)
+			sum += _strings[i - 1].compareToIgnoreCase(_strings[i]) < 0;
+		g_sink += sum;
+	}
+};
+
+struct StringHash : public StringCopy {
+	explicit StringHash(uint length) : StringCopy(length) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (uint i = 0; i < _strings.size(); ++i)
+			sum += Common::hashit_lower(_strings[i].c_str());
+		g_sink += sum;
+	}
+};
+
+void runStringBenchmarks(Runner &runner, const char *group, uint length) {
+	StringCopy copy(length);
+	runner.run(group, "copy", kNumKeys, copy);
+
+	StringAppend append(length);
+	runner.run(group, "append_char", kNumKeys / 10 * length, append);
+
+	StringCompare compare(length);
+	runner.run(group, "compare_ignore_case", kNumKeys - 1, compare);
+
+	StringHash hash(length);
+	runner.run(group, "hash_lower", kNumKeys, hash);
+}
+
+} // End of anonymous namespace
+
+void runContainerBenchmarks(Runner &runner) {
+	Common::Array<int> intKeys, intMissing;
+	makeIntKeys(intKeys, intMissing);
+	Common::Array<Common::String> strKeys, strMissing;
+	makeStringKeys(strKeys, strMissing);
+
+	typedef Common::HashMap<int, int> IntHashMap;
+	typedef Common::FlatHashMap<int, int> IntFlatHashMap;
+	typedef Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringHashMap;
+	typedef Common::FlatHashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringFlatHashMap;
+
+	runMapBenchmarks<IntHashMap>(runner, "hashmap_int", intKeys, intMissing);
+	runMapBenchmarks<IntFlatHashMap>(runner, "flathashmap_int", intKeys, intMissing);
+	runMapBenchmarks<StringHashMap>(runner, "hashmap_string", strKeys, strMissing);
+	runMapBenchmarks<StringFlatHashMap>(runner, "flathashmap_string", strKeys, strMissing);
+
+	ArrayPushBack arrayPushBack;
+	runner.run("array", "push_back", kNumKeys, arrayPushBack);
+	ArrayIterate arrayIterate;
+	runner.run("array", "iterate", kNumKeys, arrayIterate);
+
+	ListPushBack listPushBack;
+	runner.run("list", "push_back", kNumKeys, listPushBack);
+	ListIterate listIterate;
+	runner.run("list", "iterate", kNumKeys, listIterate);
+
+	// 16 characters fit into the builtin storage, 64 do not.
+	runStringBenchmarks(runner, "string_builtin", 16);
+	runStringBenchmarks(runner, "string_extern", 64);
+}
+
+} // End of namespace Benchmark
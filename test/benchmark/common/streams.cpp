@@ -0,0 +1,234 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/bitstream.h"
+#include "common/bufferedstream.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kDataSize = 64 * 1024,
+	kNumSeeks = 4096,
+	kNumBitReads = 40000,
+	kNumSymbols = 20000
+};
+
+/** Shared, randomly filled input buffer. */
+struct Input {
+	byte _data[kDataSize];
+
+	Input() {
+		Random rnd;
+		rnd.fill(_data, kDataSize);
+	}
+};
+
+struct MemoryReadByte {
+	const Input &_input;
+	explicit MemoryReadByte(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kDataSize; ++i)
+			sum += stream.readByte();
+		g_sink += sum;
+	}
+};
+
+struct MemoryReadUint32 {
+	const Input &_input;
+	explicit MemoryReadUint32(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kDataSize / 4; ++i)
+			sum += stream.readUint32LE();
+		g_sink += sum;
+	}
+};
+
+struct MemoryReadBlock {
+	const Input &_input;
+	explicit MemoryReadBlock(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		byte buffer[256];
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kDataSize / sizeof(buffer); ++i) {
+			stream.read(buffer, sizeof(buffer));
+			sum += buffer[i & 0xFF];
+		}
+		g_sink += sum;
+	}
+};
+
+struct BufferedReadByte {
+	const Input &_input;
+	explicit BufferedReadByte(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::SeekableReadStream *stream = Common::wrapBufferedSeekableReadStream(
+			new Common::MemoryReadStream(_input._data, kDataSize), 4096, DisposeAfterUse::YES);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kDataSize; ++i)
+			sum += stream->readByte();
+		delete stream;
+		g_sink += sum;
+	}
+};
+
+struct BufferedSeekRead {
+	const Input &_input;
+	uint32 _offsets[kNumSeeks];
+
+	explicit BufferedSeekRead(const Input &input) : _input(input) {
+		// Mostly short forward seeks, as done when walking resource
+		// tables, with an occasional jump somewhere else.
+		Random rnd;
+		uint32 pos = 0;
+		for (uint32 i = 0; i < kNumSeeks; ++i) {
+			if (rnd.next(8) == 0)
+				pos = rnd.next(kDataSize - 4);
+			else
+				pos = (pos + rnd.next(64)) % (kDataSize - 4);
+			_offsets[i] = pos;
+		}
+	}
+
+	void operator()() {
+		Common::SeekableReadStream *stream = Common::wrapBufferedSeekableReadStream(
+			new Common::MemoryReadStream(_input._data, kDataSize), 4096, DisposeAfterUse::YES);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kNumSeeks; ++i) {
+			stream->seek(_offsets[i]);
+			sum += stream->readUint32LE();
+		}
+		delete stream;
+		g_sink += sum;
+	}
+};
+
+template<class BitStreamType>
+struct BitStreamGetBits {
+	const Input &_input;
+	explicit BitStreamGetBits(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		BitStreamType bits(stream);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kNumBitReads; ++i)
+			sum += bits.getBits((i & 15) + 1);
+		g_sink += sum;
+	}
+};
+
+template<class BitStreamType>
+struct BitStreamGetBit {
+	const Input &_input;
+	explicit BitStreamGetBit(const Input &input) : _input(input) {}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		BitStreamType bits(stream);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kNumBitReads; ++i)
+			sum += bits.getBit();
+		g_sink += sum;
+	}
+};
+
+/**
+ * Decode random data with a complete canonical Huffman code of 16 symbols,
+ * i.e. every bit sequence decodes to valid symbols.
+ */
+struct HuffmanDecode {
+	const Input &_input;
+	Common::Huffman *_huffman;
+
+	explicit HuffmanDecode(const Input &input) : _input(input) {
+		static const uint8 lengths[16] = { 2, 2, 3, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 13 };
+		uint32 codes[16];
+		uint32 code = 0;
+		for (int i = 0; i < 16; ++i) {
+			codes[i] = code;
+			if (i < 15)
+				code = (code + 1) << (lengths[i + 1] - lengths[i]);
+		}
+
+		_huffman = new Common::Huffman(0, 16, codes, lengths);
+	}
+
+	~HuffmanDecode() {
+		delete _huffman;
+	}
+
+	void operator()() {
+		Common::MemoryReadStream stream(_input._data, kDataSize);
+		Common::BitStream8MSB bits(stream);
+		uint32 sum = 0;
+		for (uint32 i = 0; i < kNumSymbols; ++i)
+			sum += _huffman->getSymbol(bits);
+		g_sink += sum;
+	}
+};
+
+} // End of anonymous namespace
+
+void runStreamBenchmarks(Runner &runner) {
+	Input *input = new Input();
+
+	MemoryReadByte memoryReadByte(*input);
+	runner.run("memoryreadstream", "read_byte", kDataSize, memoryReadByte);
+	MemoryReadUint32 memoryReadUint32(*input);
+	runner.run("memoryreadstream", "read_uint32le", kDataSize / 4, memoryReadUint32);
+	MemoryReadBlock memoryReadBlock(*input);
+	runner.run("memoryreadstream", "read_256_bytes", kDataSize / 256, memoryReadBlock);
+
+	BufferedReadByte bufferedReadByte(*input);
+	runner.run("bufferedseekablereadstream", "read_byte", kDataSize, bufferedReadByte);
+	BufferedSeekRead bufferedSeekRead(*input);
+	runner.run("bufferedseekablereadstream", "seek_read_uint32le", kNumSeeks, bufferedSeekRead);
+
+	BitStreamGetBits<Common::BitStream8MSB> bitStream8MSBGetBits(*input);
+	runner.run("bitstream", "8msb_get_bits", kNumBitReads, bitStream8MSBGetBits);
+	BitStreamGetBit<Common::BitStream8MSB> bitStream8MSBGetBit(*input);
+	runner.run("bitstream", "8msb_get_bit", kNumBitReads, bitStream8MSBGetBit);
+	BitStreamGetBits<Common::BitStream32LELSB> bitStream32LELSBGetBits(*input);
+	runner.run("bitstream", "32lelsb_get_bits", kNumBitReads, bitStream32LELSBGetBits);
+
+	HuffmanDecode huffmanDecode(*input);
+	runner.run("huffman", "get_symbol", kNumSymbols, huffmanDecode);
+
+	delete input;
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "test/benchmark/benchmark.h"
+#include "test/common/encoders.h"
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+#include "engines/sci/decompressor.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kNumResources = 24
+};
+
+/**
+ * A set of STACpack compressed resources of all kinds and with sizes from
+ * 2 KiB to 64 KiB, as found in SCI32 resource volumes.
+ */
+struct LZSCorpus {
+	Common::Array<byte> _packed[kNumResources];
+	uint32 _unpackedSize[kNumResources];
+	uint32 _totalSize;
+	byte *_target;
+
+	LZSCorpus() : _totalSize(0) {
+		Random rnd;
+		uint32 maxSize = 0;
+		for (int i = 0; i < kNumResources; ++i) {
+			const uint32 size = 2048 << (i % 6);
+			Common::Array<byte> data;
+			data.resize(size);
+			generateResource((ResourceKind)(i % kResourceKindCount), data.begin(), size, rnd);
+			TestEncoders::encodeLZS(data.begin(), size, _packed[i]);
+
+			_unpackedSize[i] = size;
+			_totalSize += size;
+			maxSize = MAX(maxSize, size);
+		}
+		_target = new byte[maxSize];
+	}
+
+	~LZSCorpus() {
+		delete[] _target;
+	}
+};
+
+struct LZSDecompress {
+	LZSCorpus &_corpus;
+	Sci::DecompressorLZS _lzs;
+	explicit LZSDecompress(LZSCorpus &corpus) : _corpus(corpus) {}
+
+	void operator()() {
+		uint32 sum = 0;
+		for (int i = 0; i < kNumResources; ++i) {
+			Common::MemoryReadStream src(_corpus._packed[i].begin(), _corpus._packed[i].size());
+			sum += _lzs.unpack(&src, _corpus._target, _corpus._packed[i].size(), _corpus._unpackedSize[i]);
+			sum += _corpus._target[i];
+		}
+		g_sink += sum;
+	}
+};
+
+} // End of anonymous namespace
+
+void runSciBenchmarks(Runner &runner) {
+	LZSCorpus *lzsCorpus = new LZSCorpus();
+
+	// Bytes of unpacked data per second
+	LZSDecompress lzsDecompress(*lzsCorpus);
+	runner.run("sci_lzs", "decompress", lzsCorpus->_totalSize, lzsDecompress);
+
+	delete lzsCorpus;
+}
+
+} // End of namespace Benchmark
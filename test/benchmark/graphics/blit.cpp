@@ -0,0 +1,209 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/array.h"
+#include "graphics/transform_cache.h"
+#include "graphics/transparent_surface.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kScreenWidth = 800,
+	kScreenHeight = 600,
+	kNumSprites = 8,
+	kNumBlits = 200
+};
+
+/** One recorded call of TransparentSurface::blit. */
+struct BlitCall {
+	int sprite;
+	int posX, posY;
+	int flipping;
+	uint32 color;
+	Graphics::TSpriteBlendMode blendMode;
+};
+
+/**
+ * Replay a frame's worth of sprite draws onto an 800x600 screen, as the
+ * Wintermute renderer issues them: mostly plain alpha blended sprites of
+ * assorted sizes, some of them flipped, faded or tinted, and a few
+ * additive or otherwise blended effects.
+ */
+struct BlitStream {
+	Graphics::TransparentSurface _sprites[kNumSprites];
+	Graphics::Surface _screen;
+	Common::Array<BlitCall> _calls;
+	uint32 _pixels;
+
+	/**
+	 * @param blendMode the blend mode of all blits, or BLEND_UNKNOWN for
+	 *                  the typical mix of them
+	 * @param tinted    whether the blits use a colormod
+	 */
+	BlitStream(Graphics::TSpriteBlendMode blendMode, bool tinted) : _pixels(0) {
+		static const int spriteSizes[kNumSprites][2] = {
+			{ 16, 16 }, { 32, 48 }, { 61, 93 }, { 100, 20 },
+			{ 128, 128 }, { 150, 230 }, { 257, 64 }, { 400, 300 }
+		};
+
+		Random rnd;
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+
+		for (int i = 0; i < kNumSprites; ++i) {
+			Graphics::TransparentSurface &sprite = _sprites[i];
+			sprite.create(spriteSizes[i][0], spriteSizes[i][1], format);
+
+			// An opaque shape with soft edges on a transparent background
+			const int cx = sprite.w / 2, cy = sprite.h / 2;
+			const int radius = MIN(cx, cy);
+			for (int y = 0; y < sprite.h; ++y) {
+				for (int x = 0; x < sprite.w; ++x) {
+					const int dist = MAX(ABS(x - cx), ABS(y - cy));
+					const uint32 alpha = dist < radius - 4 ? 255 : (dist < radius ? (radius - dist) * 63 : 0);
+					*(uint32 *)sprite.getBasePtr(x, y) = (rnd.next() & 0xFFFFFF00) | alpha;
+				}
+			}
+		}
+
+		_screen.create(kScreenWidth, kScreenHeight, format);
+		rnd.fill((byte *)_screen.getPixels(), _screen.pitch * _screen.h);
+
+		for (int i = 0; i < kNumBlits; ++i) {
+			BlitCall call;
+			call.sprite = rnd.next(kNumSprites);
+			const Graphics::TransparentSurface &sprite = _sprites[call.sprite];
+			call.posX = (int)rnd.next(kScreenWidth) - sprite.w / 2;
+			call.posY = (int)rnd.next(kScreenHeight) - sprite.h / 2;
+			call.flipping = rnd.next(4) == 0 ? Graphics::FLIP_H : Graphics::FLIP_NONE;
+			if (rnd.next(16) == 0)
+				call.flipping |= Graphics::FLIP_V;
+
+			call.color = 0xFFFFFFFF;
+			if (tinted)
+				call.color = rnd.next() | 0x40000000;
+
+			call.blendMode = blendMode;
+			if (blendMode == Graphics::BLEND_UNKNOWN) {
+				const uint32 kind = rnd.next(16);
+				call.blendMode = kind < 12 ? Graphics::BLEND_NORMAL : (kind < 14 ? Graphics::BLEND_ADDITIVE :
+				                 (kind < 15 ? Graphics::BLEND_SUBTRACTIVE : Graphics::BLEND_MULTIPLY));
+				if (kind < 3)
+					call.color = 0x80FFFFFF;
+				else if (kind < 4)
+					call.color = 0xFFFF8040;
+			}
+
+			_calls.push_back(call);
+
+			Common::Rect visible(call.posX, call.posY, call.posX + sprite.w, call.posY + sprite.h);
+			visible.clip(kScreenWidth, kScreenHeight);
+			_pixels += visible.width() * visible.height();
+		}
+	}
+
+	~BlitStream() {
+		for (int i = 0; i < kNumSprites; ++i)
+			_sprites[i].free();
+		_screen.free();
+	}
+
+	void operator()() {
+		for (uint i = 0; i < _calls.size(); ++i) {
+			const BlitCall &call = _calls[i];
+			_sprites[call.sprite].blit(_screen, call.posX, call.posY, call.flipping, nullptr, call.color, -1, -1, call.blendMode);
+		}
+		g_sink += *(const uint32 *)_screen.getBasePtr(kScreenWidth / 2, kScreenHeight / 2);
+	}
+};
+
+void runBlitStream(Runner &runner, const char *name, Graphics::TSpriteBlendMode blendMode, bool tinted) {
+	BlitStream stream(blendMode, tinted);
+	runner.run("blit_800x600", name, stream._pixels, stream);
+}
+
+/**
+ * Scale an actor sized sprite, as a Wintermute render ticket does for
+ * every sprite drawn in a scaled part of a scene. Without the cache, this
+ * scales it from scratch every time.
+ */
+struct ScaleSprite {
+	Graphics::TransparentSurface _sprite;
+	Graphics::TransformCache *_cache;
+	const Common::Rect _srcRect;
+
+	enum {
+		kWidth = 120,
+		kHeight = 260,
+		kScaledWidth = 93,
+		kScaledHeight = 201
+	};
+
+	ScaleSprite(Graphics::TransformCache *cache) : _cache(cache), _srcRect(0, 0, kWidth, kHeight) {
+		_sprite.create(kWidth, kHeight, Graphics::TransparentSurface::getSupportedPixelFormat());
+		Random rnd;
+		rnd.fill((byte *)_sprite.getPixels(), _sprite.pitch * _sprite.h);
+	}
+
+	~ScaleSprite() {
+		_sprite.free();
+	}
+
+	void operator()() {
+		Graphics::Surface copy;
+		if (_cache) {
+			copy.copyFrom(*_cache->scale(this, _sprite, _srcRect, kScaledWidth, kScaledHeight, Graphics::FILTER_BILINEAR));
+		} else {
+			Graphics::TransparentSurface *scaled = _sprite.scaleT<Graphics::FILTER_BILINEAR>(kScaledWidth, kScaledHeight);
+			copy.copyFrom(*scaled);
+			scaled->free();
+			delete scaled;
+		}
+		g_sink += *(const uint32 *)copy.getBasePtr(kScaledWidth / 2, kScaledHeight / 2);
+		copy.free();
+	}
+};
+
+} // End of anonymous namespace
+
+void runBlitBenchmarks(Runner &runner) {
+	runBlitStream(runner, "alpha", Graphics::BLEND_NORMAL, false);
+	runBlitStream(runner, "alpha_tinted", Graphics::BLEND_NORMAL, true);
+	runBlitStream(runner, "additive", Graphics::BLEND_ADDITIVE, false);
+	runBlitStream(runner, "additive_tinted", Graphics::BLEND_ADDITIVE, true);
+	runBlitStream(runner, "subtractive", Graphics::BLEND_SUBTRACTIVE, false);
+	runBlitStream(runner, "subtractive_tinted", Graphics::BLEND_SUBTRACTIVE, true);
+	runBlitStream(runner, "multiply", Graphics::BLEND_MULTIPLY, false);
+	runBlitStream(runner, "multiply_tinted", Graphics::BLEND_MULTIPLY, true);
+	runBlitStream(runner, "mixed", Graphics::BLEND_UNKNOWN, false);
+
+	ScaleSprite scale(nullptr);
+	runner.run("transform", "scale_bilinear", ScaleSprite::kScaledWidth * ScaleSprite::kScaledHeight, scale);
+	Graphics::TransformCache cache;
+	ScaleSprite scaleCached(&cache);
+	runner.run("transform", "scale_bilinear_cached", ScaleSprite::kScaledWidth * ScaleSprite::kScaledHeight, scaleCached);
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "graphics/scaler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kFrameWidth = 320,
+	kFrameHeight = 200,
+	// The scalers read one pixel beyond each edge of the source.
+	kSrcPitch = (kFrameWidth + 4) * 2,
+	kMaxScale = 3
+};
+
+/**
+ * Scale one 320x200 frame, as the SDL backend does for a full screen
+ * update. The source resembles game graphics: flat areas, dithering and
+ * some edges, rather than pure noise.
+ */
+struct ScaleFrame {
+	ScalerProc *_proc;
+	const int _scale;
+	byte *_src;
+	byte *_dst;
+
+	ScaleFrame(ScalerProc *proc, int scale) : _proc(proc), _scale(scale) {
+		_src = (byte *)malloc(kSrcPitch * (kFrameHeight + 2));
+		_dst = (byte *)malloc(kSrcPitch * kMaxScale * kFrameHeight * kMaxScale);
+
+		Random rnd;
+		uint16 palette[16];
+		for (int i = 0; i < 16; ++i)
+			palette[i] = (uint16)rnd.next();
+
+		uint16 *pixels = (uint16 *)_src;
+		for (int y = 0; y < kFrameHeight + 2; ++y) {
+			for (int x = 0; x < kFrameWidth + 4; ++x) {
+				int color = ((x / 16) * 3 + (y / 12) * 5) & 15;
+				if (((x ^ y) & 1) && (x & 32))
+					color = (color + 1) & 15;
+				if (rnd.next(64) == 0)
+					color = rnd.next(16);
+				pixels[y * (kSrcPitch / 2) + x] = palette[color];
+			}
+		}
+	}
+
+	~ScaleFrame() {
+		free(_src);
+		free(_dst);
+	}
+
+	void operator()() {
+		const uint32 dstPitch = kSrcPitch * _scale;
+		_proc(_src + kSrcPitch + 2, kSrcPitch, _dst, dstPitch, kFrameWidth, kFrameHeight);
+		g_sink += _dst[(kFrameHeight / 2) * dstPitch + kFrameWidth];
+	}
+};
+
+void runScaler(Runner &runner, const char *name, ScalerProc *proc, int scale) {
+	ScaleFrame scaleFrame(proc, scale);
+	runner.run("scaler_320x200", name, 1, scaleFrame);
+}
+
+} // End of anonymous namespace
+
+void runGraphicsBenchmarks(Runner &runner) {
+	InitScalers(565);
+
+	runScaler(runner, "normal1x", Normal1x, 1);
+#ifdef USE_SCALERS
+	runScaler(runner, "normal2x", Normal2x, 2);
+	runScaler(runner, "normal3x", Normal3x, 3);
+	runScaler(runner, "advmame2x", AdvMame2x, 2);
+	runScaler(runner, "advmame3x", AdvMame3x, 3);
+	runScaler(runner, "2xsai", _2xSaI, 2);
+	runScaler(runner, "super2xsai", Super2xSaI, 2);
+	runScaler(runner, "supereagle", SuperEagle, 2);
+	runScaler(runner, "tv2x", TV2x, 2);
+	runScaler(runner, "dotmatrix", DotMatrix, 2);
+#ifdef USE_HQ_SCALERS
+	runScaler(runner, "hq2x", HQ2x, 2);
+	runScaler(runner, "hq3x", HQ3x, 3);
+#endif
+#endif
+
+	DestroyScalers();
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,110 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+namespace Benchmark {
+
+namespace {
+
+/**
+ * Convert one frame of YUV data, as the video decoders do for every frame.
+ * The planes hold smooth gradients with some noise, like video content.
+ */
+struct ConvertFrame {
+	const int _subsampling;
+	const int _width, _height;
+	byte *_y, *_u, *_v;
+	int _uvPitch;
+	Graphics::Surface _surface;
+
+	ConvertFrame(int subsampling, int width, int height, const Graphics::PixelFormat &format) :
+			_subsampling(subsampling), _width(width), _height(height) {
+		const int uvShift = (subsampling == 444) ? 0 : (subsampling == 420) ? 1 : 2;
+		_uvPitch = (width >> uvShift) + 1;
+		const int uvHeight = (height >> uvShift) + 1;
+
+		Random rnd;
+		_y = new byte[width * height];
+		_u = new byte[_uvPitch * uvHeight];
+		_v = new byte[_uvPitch * uvHeight];
+
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				_y[y * width + x] = (byte)((x + y) / 8 + rnd.next(16));
+		for (int i = 0; i < _uvPitch * uvHeight; ++i) {
+			_u[i] = (byte)(96 + (i & 63) + rnd.next(8));
+			_v[i] = (byte)(160 - (i & 63) + rnd.next(8));
+		}
+
+		_surface.create(width, height, format);
+	}
+
+	~ConvertFrame() {
+		delete[] _y;
+		delete[] _u;
+		delete[] _v;
+		_surface.free();
+	}
+
+	void operator()() {
+		switch (_subsampling) {
+		case 444:
+			YUVToRGBMan.convert444(&_surface, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, _width, _height, _width, _uvPitch);
+			break;
+		case 420:
+			YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, _width, _height, _width, _uvPitch);
+			break;
+		default:
+			YUVToRGBMan.convert410(&_surface, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, _width, _height, _width, _uvPitch);
+			break;
+		}
+
+		g_sink += *(const byte *)_surface.getBasePtr(_width / 2, _height / 2);
+	}
+};
+
+void runConversion(Runner &runner, const char *name, int subsampling, int width, int height, const Graphics::PixelFormat &format) {
+	ConvertFrame convertFrame(subsampling, width, height, format);
+	runner.run("yuv_to_rgb", name, width * height, convertFrame);
+}
+
+} // End of anonymous namespace
+
+void runYUVBenchmarks(Runner &runner) {
+	const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+	runConversion(runner, "420_640x480_16bpp", 420, 640, 480, rgb565);
+	runConversion(runner, "420_640x480_32bpp", 420, 640, 480, argb8888);
+	runConversion(runner, "420_1280x720_16bpp", 420, 1280, 720, rgb565);
+	runConversion(runner, "420_1280x720_32bpp", 420, 1280, 720, argb8888);
+	runConversion(runner, "420_1920x1080_16bpp", 420, 1920, 1080, rgb565);
+	runConversion(runner, "420_1920x1080_32bpp", 420, 1920, 1080, argb8888);
+	runConversion(runner, "444_640x480_32bpp", 444, 640, 480, argb8888);
+	runConversion(runner, "410_640x480_32bpp", 410, 640, 480, argb8888);
+}
+
+} // End of namespace Benchmark
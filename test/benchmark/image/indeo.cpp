@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kFrameWidth = 640,
+	kFrameHeight = 480
+};
+
+/**
+ * Output the luma plane of one 640x480 Indeo frame, as the decoder does
+ * for every frame once its bands are decoded. Scalable frames recompose
+ * the plane from four wavelet bands, the others just clip a single band.
+ */
+struct OutputFrame {
+	enum Mode {
+		kModePlane,
+		kModeHaar,
+		kMode53
+	};
+
+	const Mode _mode;
+	int16 *_coeffs[4];
+	Image::Indeo::IVIBandDesc _bands[4];
+	Image::Indeo::IVIPlaneDesc _plane;
+	byte *_dst;
+
+	OutputFrame(Mode mode) : _mode(mode) {
+		// Wavelet bands have half the width and height of the plane
+		const int bandWidth = (mode == kModePlane) ? kFrameWidth : kFrameWidth / 2;
+		const int bandHeight = (mode == kModePlane) ? kFrameHeight : kFrameHeight / 2;
+
+		Random rnd;
+		for (int b = 0; b < 4; b++) {
+			_coeffs[b] = new int16[bandWidth * bandHeight];
+			for (int i = 0; i < bandWidth * bandHeight; i++) {
+				// Low pass coefficients carry the picture, the others are
+				// mostly small corrections.
+				if (b == 0)
+					_coeffs[b][i] = (int16)((mode == kModePlane) ? rnd.next(256) - 128 : rnd.next(1024) - 512);
+				else
+					_coeffs[b][i] = (rnd.next(4) == 0) ? (int16)rnd.next(64) - 32 : 0;
+			}
+
+			_bands[b]._buf = _coeffs[b];
+			_bands[b]._pitch = bandWidth;
+		}
+
+		_plane._width = kFrameWidth;
+		_plane._height = kFrameHeight;
+		_plane._numBands = (mode == kModePlane) ? 1 : 4;
+		_plane._bands = _bands;
+
+		_dst = new byte[kFrameWidth * kFrameHeight];
+	}
+
+	~OutputFrame() {
+		for (int b = 0; b < 4; b++)
+			delete[] _coeffs[b];
+		delete[] _dst;
+	}
+
+	void operator()() {
+		switch (_mode) {
+		case kModePlane:
+			Image::Indeo::IndeoDSP::ffIviOutputPlane(&_plane, _dst, kFrameWidth);
+			break;
+		case kModeHaar:
+			Image::Indeo::IndeoDSP::ffIviRecomposeHaar(&_plane, _dst, kFrameWidth);
+			break;
+		default:
+			Image::Indeo::IndeoDSP::ffIviRecompose53(&_plane, _dst, kFrameWidth);
+			break;
+		}
+
+		g_sink += _dst[kFrameWidth * kFrameHeight / 2 + kFrameWidth / 2];
+	}
+};
+
+} // End of anonymous namespace
+
+void runImageBenchmarks(Runner &runner) {
+	OutputFrame outputPlane(OutputFrame::kModePlane);
+	runner.run("indeo", "output_plane_640x480", kFrameWidth * kFrameHeight, outputPlane);
+
+	OutputFrame recomposeHaar(OutputFrame::kModeHaar);
+	runner.run("indeo", "recompose_haar_640x480", kFrameWidth * kFrameHeight, recomposeHaar);
+
+	OutputFrame recompose53(OutputFrame::kMode53);
+	runner.run("indeo", "recompose53_640x480", kFrameWidth * kFrameHeight, recompose53);
+}
+
+} // End of namespace Benchmark
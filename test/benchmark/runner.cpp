@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/util.h"
+
+#include <stdlib.h>
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+namespace Benchmark {
+
+volatile uint32 g_sink = 0;
+
+Runner::Runner(int argc, char **argv) : _minTime(200 * 1000000ULL), _repetitions(3) {
+	for (int i = 1; i < argc; ++i) {
+		const Common::String arg(argv[i]);
+		if (arg.hasPrefix("--filter=")) {
+			_filter = Common::String(arg.c_str() + 9);
+		} else if (arg.hasPrefix("--min-time=")) {
+			_minTime = (uint64)atoi(arg.c_str() + 11) * 1000000ULL;
+		} else if (arg.hasPrefix("--repetitions=")) {
+			_repetitions = MAX(1, atoi(arg.c_str() + 14));
+		} else {
+			fprintf(stderr, "Usage: %s [--filter=<group/name substring>] [--min-time=<ms>] [--repetitions=<n>]\n", argv[0]);
+			exit(1);
+		}
+	}
+
+	printf("group,name,items,iterations,ns_per_item,items_per_second\n");
+}
+
+bool Runner::isEnabled(const char *group, const char *name) const {
+	if (_filter.empty())
+		return true;
+
+	const Common::String fullName = Common::String::format("%s/%s", group, name);
+	return fullName.contains(_filter.c_str());
+}
+
+void Runner::report(const char *group, const char *name, uint32 items, uint32 iterations, uint64 elapsed) {
+	const double totalItems = (double)items * (double)iterations;
+	const double nsPerItem = (double)elapsed / totalItems;
+	const double itemsPerSecond = elapsed ? totalItems * 1e9 / (double)elapsed : 0.0;
+
+	printf("%s,%s,%u,%u,%.3f,%.0f\n", group, name, items, iterations, nsPerItem, itemsPerSecond);
+	fflush(stdout);
+}
+
+} // End of namespace Benchmark
+
+int main(int argc, char **argv) {
+	Benchmark::Runner runner(argc, argv);
+
+	Benchmark::runContainerBenchmarks(runner);
+	Benchmark::runStreamBenchmarks(runner);
+	Benchmark::runCompressionBenchmarks(runner);
+	Benchmark::runAudioBenchmarks(runner);
+	Benchmark::runGraphicsBenchmarks(runner);
+	Benchmark::runBlitBenchmarks(runner);
+	Benchmark::runYUVBenchmarks(runner);
+	Benchmark::runImageBenchmarks(runner);
+#ifdef USE_BINK
+	Benchmark::runVideoBenchmarks(runner);
+#endif
+#ifdef BENCHMARK_SCI
+	Benchmark::runSciBenchmarks(runner);
+#endif
+
+	return 0;
+}
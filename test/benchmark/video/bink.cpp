@@ -0,0 +1,167 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#ifdef USE_BINK
+
+#include "video/bink_dsp.h"
+
+#include <string.h>
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kFrameWidth = 640,
+	kFrameHeight = 480,
+	kNumCoeffBlocks = 256
+};
+
+/**
+ * Reconstruct the pixels of one synthetic 640x480 Bink frame: the luma
+ * plane and both quarter size chroma planes, with a mix of block types
+ * like in typical FMV content. Only the block kernels are timed, not the
+ * bitstream parsing, so the result shows the upper limit of frames per
+ * second the reconstruction allows.
+ */
+struct ReconstructFrame {
+	byte *_planes[3];
+	byte *_prevPlanes[3];
+	int16 _coeffs[kNumCoeffBlocks][64];
+	byte _raw[64];
+
+	ReconstructFrame() {
+		Random rnd;
+		for (int i = 0; i < 3; ++i) {
+			const uint32 size = kFrameWidth * kFrameHeight / (i ? 4 : 1);
+			_planes[i] = new byte[size];
+			_prevPlanes[i] = new byte[size];
+			rnd.fill(_planes[i], size);
+			rnd.fill(_prevPlanes[i], size);
+		}
+
+		// Mostly sparse, low frequency coefficients, like dequantized
+		// blocks of real videos.
+		for (int n = 0; n < kNumCoeffBlocks; ++n) {
+			for (int i = 0; i < 64; ++i) {
+				const bool set = (i < 16) ? rnd.next(3) == 0 : rnd.next(16) == 0;
+				_coeffs[n][i] = set ? (int16)rnd.next(512) - 256 : 0;
+			}
+		}
+
+		rnd.fill(_raw, sizeof(_raw));
+	}
+
+	~ReconstructFrame() {
+		for (int i = 0; i < 3; ++i) {
+			delete[] _planes[i];
+			delete[] _prevPlanes[i];
+		}
+	}
+
+	void reconstructPlane(byte *dest, const byte *prev, uint32 width, uint32 height) {
+		uint32 n = 0;
+		for (uint32 y = 0; y < height; y += 8) {
+			for (uint32 x = 0; x < width; x += 8, ++n) {
+				byte *block = dest + y * width + x;
+				const int16 *coeffs = _coeffs[n % kNumCoeffBlocks];
+
+				switch (n % 8) {
+				case 0:
+					Video::binkIDCTPut(block, width, coeffs);
+					break;
+				case 1:
+				case 2:
+				case 3:
+					for (int j = 0; j < 8; ++j)
+						memcpy(block + j * width, prev + (y + j) * width + x, 8);
+					Video::binkIDCTAdd(block, width, coeffs);
+					break;
+				case 4:
+					for (int j = 0; j < 8; ++j)
+						memcpy(block + j * width, prev + (y + j) * width + x, 8);
+					Video::binkAddResidue(block, width, coeffs);
+					break;
+				case 5:
+					if ((y & 8) == 0 && x + 16 <= width && y + 16 <= height) {
+						Video::binkIDCTPutScaled(block, width, coeffs);
+						break;
+					}
+					// fall through
+				case 6:
+					if ((y & 8) == 0 && x + 16 <= width && y + 16 <= height) {
+						Video::binkPutScaled(block, width, _raw);
+						break;
+					}
+					// fall through
+				default:
+					for (int j = 0; j < 8; ++j)
+						memcpy(block + j * width, prev + (y + j) * width + x, 8);
+					break;
+				}
+			}
+		}
+	}
+
+	void operator()() {
+		reconstructPlane(_planes[0], _prevPlanes[0], kFrameWidth, kFrameHeight);
+		reconstructPlane(_planes[1], _prevPlanes[1], kFrameWidth / 2, kFrameHeight / 2);
+		reconstructPlane(_planes[2], _prevPlanes[2], kFrameWidth / 2, kFrameHeight / 2);
+		g_sink += _planes[0][kFrameWidth * kFrameHeight / 2] + _planes[1][0];
+	}
+};
+
+/** Transform a batch of blocks in place, as the 16x16 intra blocks do. */
+struct TransformBlocks {
+	int16 _source[kNumCoeffBlocks][64];
+	int16 _blocks[kNumCoeffBlocks][64];
+
+	TransformBlocks() {
+		Random rnd;
+		for (int n = 0; n < kNumCoeffBlocks; ++n)
+			for (int i = 0; i < 64; ++i)
+				_source[n][i] = (i < 16 || rnd.next(8) == 0) ? (int16)rnd.next(512) - 256 : 0;
+	}
+
+	void operator()() {
+		memcpy(_blocks, _source, sizeof(_blocks));
+		for (int n = 0; n < kNumCoeffBlocks; ++n)
+			Video::binkIDCT(_blocks[n]);
+		g_sink += _blocks[kNumCoeffBlocks / 2][9];
+	}
+};
+
+} // End of anonymous namespace
+
+void runVideoBenchmarks(Runner &runner) {
+	TransformBlocks transformBlocks;
+	runner.run("bink", "idct", kNumCoeffBlocks, transformBlocks);
+
+	ReconstructFrame reconstructFrame;
+	runner.run("bink", "reconstruct_640x480", 1, reconstructFrame);
+}
+
+} // End of namespace Benchmark
+
+#endif
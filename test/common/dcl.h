@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/dcl.h"
+#include "common/memstream.h"
+
+#include "test/common/encoders.h"
+
+/**
+ * Tests for the PKWARE DCL decompressor. decompressDCL() with a target
+ * buffer decodes from memory with lookup tables, while the overloads
+ * returning a stream still use the bit by bit decoder, so the results of
+ * both are compared as well.
+ */
+class DCLTestSuite : public CxxTest::TestSuite {
+	uint32 _state;
+
+	uint32 nextRandom() {
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	/** Generate data with repetitions, like most game resources. */
+	void generate(Common::Array<byte> &data, uint32 size) {
+		data.resize(size);
+		for (uint32 i = 0; i < size; ) {
+			uint32 offset = nextRandom() % 300 + 1;
+			uint32 length = nextRandom() % 40 + 1;
+			if (nextRandom() % 3 == 0 || offset > i) {
+				data[i++] = (nextRandom() % 4 == 0) ? nextRandom() : 'a' + nextRandom() % 8;
+			} else {
+				for (; length && i < size; --length, ++i)
+					data[i] = data[i - offset];
+			}
+		}
+	}
+
+	/**
+	 * Decompress with both decoders, check that they agree and return the
+	 * result of the memory based one.
+	 */
+	bool decompressBoth(const Common::Array<byte> &packed, Common::Array<byte> &unpacked, uint32 unpackedSize) {
+		unpacked.resize(unpackedSize);
+		Common::MemoryReadStream src(packed.begin(), packed.size());
+		const bool success = Common::decompressDCL(&src, unpacked.begin(), packed.size(), unpackedSize);
+
+		Common::MemoryReadStream streamSrc(packed.begin(), packed.size());
+		Common::SeekableReadStream *reference = Common::decompressDCL(&streamSrc, packed.size(), unpackedSize);
+		TS_ASSERT_EQUALS(success, reference != nullptr);
+		if (success && reference) {
+			Common::Array<byte> expected;
+			expected.resize(unpackedSize);
+			reference->read(expected.begin(), unpackedSize);
+			TS_ASSERT(expected == unpacked);
+		}
+		delete reference;
+		return success;
+	}
+
+public:
+	void setUp() {
+		_state = 0x2545F491;
+	}
+
+	void test_round_trip() {
+		static const uint32 sizes[] = { 1, 2, 3, 17, 600, 5000, 70000 };
+		for (int dictionaryType = 4; dictionaryType <= 6; ++dictionaryType) {
+			for (uint i = 0; i < ARRAYSIZE(sizes); ++i) {
+				Common::Array<byte> data, packed, unpacked;
+				generate(data, sizes[i]);
+				TestEncoders::encodeDCL(data.begin(), data.size(), dictionaryType, packed);
+
+				TS_ASSERT(decompressBoth(packed, unpacked, data.size()));
+				TS_ASSERT(unpacked == data);
+			}
+		}
+	}
+
+	void test_long_runs() {
+		// Long matches which overlap the bytes they produce
+		Common::Array<byte> data, packed, unpacked;
+		data.resize(3000);
+		memset(data.begin(), 'x', data.size());
+		data[1000] = 'y';
+		TestEncoders::encodeDCL(data.begin(), data.size(), 6, packed);
+
+		TS_ASSERT(decompressBoth(packed, unpacked, data.size()));
+		TS_ASSERT(unpacked == data);
+	}
+
+	void test_size_mismatch() {
+		Common::Array<byte> data, packed, unpacked;
+		generate(data, 1000);
+		TestEncoders::encodeDCL(data.begin(), data.size(), 5, packed);
+
+		// Ends before the declared size is reached
+		TS_ASSERT(!decompressBoth(packed, unpacked, data.size() + 1));
+		// Matches beyond the declared size
+		TS_ASSERT(!decompressBoth(packed, unpacked, data.size() - 100));
+	}
+
+	void test_truncated() {
+		// Missing data reads as zeros, so the result depends on where the
+		// stream was cut
+		Common::Array<byte> data, packed, unpacked;
+		generate(data, 2000);
+		TestEncoders::encodeDCL(data.begin(), data.size(), 6, packed);
+
+		for (uint32 size = 0; size < packed.size(); size += 37) {
+			Common::Array<byte> truncated(packed.begin(), size);
+			decompressBoth(truncated, unpacked, data.size());
+		}
+	}
+
+	void test_invalid_header() {
+		Common::Array<byte> packed, unpacked;
+		packed.resize(64);
+		memset(packed.begin(), 0, packed.size());
+
+		packed[0] = 2; // Unknown mode
+		packed[1] = 6;
+		TS_ASSERT(!decompressBoth(packed, unpacked, 16));
+
+		packed[0] = 1;
+		packed[1] = 3; // Unknown dictionary type
+		TS_ASSERT(!decompressBoth(packed, unpacked, 16));
+	}
+
+	void test_random_streams() {
+		// Random streams in both binary and ASCII mode exercise all codes,
+		// including length two matches and invalid distances
+		for (int i = 0; i < 400; ++i) {
+			Common::Array<byte> packed, unpacked;
+			packed.resize(nextRandom() % 2000 + 2);
+			for (uint32 j = 0; j < packed.size(); ++j)
+				packed[j] = nextRandom();
+			packed[0] = i & 1;
+			packed[1] = 4 + i % 3;
+
+			decompressBoth(packed, unpacked, nextRandom() % 8000 + 1);
+		}
+	}
+};
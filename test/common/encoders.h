@@ -0,0 +1,240 @@
+#ifndef TEST_COMMON_ENCODERS_H
+#define TEST_COMMON_ENCODERS_H
+
+// Simple encoders for compression formats ScummVM only decompresses. They
+// are used by the tests and benchmarks to generate input for the
+// decompressors, so they aim for correct output rather than good ratios.
+
+#include "common/array.h"
+#include "common/scummsys.h"
+#include "common/util.h"
+
+namespace TestEncoders {
+
+/**
+ * Finds repeated byte sequences with hash chains over three byte prefixes.
+ * Positions have to be inserted in ascending order.
+ */
+class MatchFinder {
+public:
+	MatchFinder(const byte *data, uint32 size, uint32 window, uint32 maxLength) :
+		_data(data), _size(size), _window(window), _maxLength(maxLength) {
+		for (int i = 0; i < kHashSize; ++i)
+			_head[i] = -1;
+		_prev.resize(size);
+	}
+
+	/**
+	 * Return the length of the longest match for the data at pos, or 0 if
+	 * there is none with at least three bytes. The offset of the match is
+	 * stored in offset. Inserts pos afterwards.
+	 */
+	uint32 find(uint32 pos, uint32 &offset) {
+		uint32 bestLength = 0;
+		if (pos + 3 <= _size) {
+			const uint32 maxLength = MIN<uint32>(_maxLength, _size - pos);
+			int32 candidate = _head[hash(pos)];
+			for (int chain = 0; chain < 32 && candidate >= 0 && pos - candidate <= _window; ++chain) {
+				uint32 length = 0;
+				while (length < maxLength && _data[candidate + length] == _data[pos + length])
+					++length;
+				if (length > bestLength) {
+					bestLength = length;
+					offset = pos - candidate;
+				}
+				candidate = _prev[candidate];
+			}
+		}
+
+		insert(pos);
+		return bestLength >= 3 ? bestLength : 0;
+	}
+
+	void insert(uint32 pos) {
+		if (pos + 3 > _size)
+			return;
+		const uint32 h = hash(pos);
+		_prev[pos] = _head[h];
+		_head[h] = pos;
+	}
+
+private:
+	enum {
+		kHashSize = 4096
+	};
+
+	uint32 hash(uint32 pos) const {
+		return ((_data[pos] << 4) ^ (_data[pos + 1] << 2) ^ _data[pos + 2] ^ (_data[pos + 2] << 8)) & (kHashSize - 1);
+	}
+
+	const byte *_data;
+	uint32 _size;
+	uint32 _window;
+	uint32 _maxLength;
+	int32 _head[kHashSize];
+	Common::Array<int32> _prev;
+};
+
+/**
+ * Writes bits to a byte array, either starting with the lowest or with the
+ * highest bit of every byte.
+ */
+template<bool MSB>
+class BitWriter {
+public:
+	explicit BitWriter(Common::Array<byte> &out) : _out(out), _bits(0), _numBits(0) {}
+
+	void putBits(uint32 value, int n) {
+		if (MSB)
+			_bits = (_bits << n) | value;
+		else
+			_bits |= value << _numBits;
+		_numBits += n;
+
+		while (_numBits >= 8) {
+			_numBits -= 8;
+			if (MSB) {
+				_out.push_back((_bits >> _numBits) & 0xFF);
+			} else {
+				_out.push_back(_bits & 0xFF);
+				_bits >>= 8;
+			}
+		}
+	}
+
+	/** Pad the last byte with zero bits. */
+	void flush() {
+		if (_numBits)
+			putBits(0, 8 - _numBits);
+	}
+
+private:
+	Common::Array<byte> &_out;
+	uint32 _bits;
+	int _numBits;
+};
+
+/**
+ * Encode data as a binary mode PKWARE DCL stream, as read by
+ * Common::decompressDCL().
+ *
+ * @param dictionaryType  4, 5 or 6 for a dictionary of 1, 2 or 4 KiB
+ */
+inline void encodeDCL(const byte *data, uint32 size, int dictionaryType, Common::Array<byte> &out) {
+	// Codes of the length and distance trees in common/dcl.cpp, with the
+	// first bit read in the lowest bit
+	static const uint16 lengthCodes[16][2] = {
+		{ 0x005, 3 }, { 0x003, 2 }, { 0x001, 3 }, { 0x006, 3 }, { 0x00a, 4 }, { 0x002, 4 }, { 0x00c, 4 }, { 0x014, 5 },
+		{ 0x004, 5 }, { 0x018, 5 }, { 0x008, 5 }, { 0x030, 6 }, { 0x010, 6 }, { 0x020, 6 }, { 0x040, 7 }, { 0x000, 7 }
+	};
+	static const uint16 distanceCodes[64][2] = {
+		{ 0x003, 2 }, { 0x00d, 4 }, { 0x005, 4 }, { 0x019, 5 }, { 0x009, 5 }, { 0x011, 5 }, { 0x001, 5 }, { 0x03e, 6 },
+		{ 0x01e, 6 }, { 0x02e, 6 }, { 0x00e, 6 }, { 0x036, 6 }, { 0x016, 6 }, { 0x026, 6 }, { 0x006, 6 }, { 0x03a, 6 },
+		{ 0x01a, 6 }, { 0x02a, 6 }, { 0x00a, 6 }, { 0x032, 6 }, { 0x012, 6 }, { 0x022, 6 }, { 0x042, 7 }, { 0x002, 7 },
+		{ 0x07c, 7 }, { 0x03c, 7 }, { 0x05c, 7 }, { 0x01c, 7 }, { 0x06c, 7 }, { 0x02c, 7 }, { 0x04c, 7 }, { 0x00c, 7 },
+		{ 0x074, 7 }, { 0x034, 7 }, { 0x054, 7 }, { 0x014, 7 }, { 0x064, 7 }, { 0x024, 7 }, { 0x044, 7 }, { 0x004, 7 },
+		{ 0x078, 7 }, { 0x038, 7 }, { 0x058, 7 }, { 0x018, 7 }, { 0x068, 7 }, { 0x028, 7 }, { 0x048, 7 }, { 0x008, 7 },
+		{ 0x0f0, 8 }, { 0x070, 8 }, { 0x0b0, 8 }, { 0x030, 8 }, { 0x0d0, 8 }, { 0x050, 8 }, { 0x090, 8 }, { 0x010, 8 },
+		{ 0x0e0, 8 }, { 0x060, 8 }, { 0x0a0, 8 }, { 0x020, 8 }, { 0x0c0, 8 }, { 0x040, 8 }, { 0x080, 8 }, { 0x000, 8 }
+	};
+
+	BitWriter<false> writer(out);
+	writer.putBits(0, 8); // Binary mode
+	writer.putBits(dictionaryType, 8);
+
+	MatchFinder finder(data, size, 64 << dictionaryType, 518);
+	uint32 pos = 0;
+	for (;;) {
+		uint32 offset = 0;
+		uint32 length = 0;
+		if (pos < size) {
+			length = finder.find(pos, offset);
+			if (!length) {
+				writer.putBits(0, 1);
+				writer.putBits(data[pos++], 8);
+				continue;
+			}
+		} else {
+			// End of stream marker
+			length = 519;
+		}
+
+		writer.putBits(1, 1);
+		if (length < 10) {
+			writer.putBits(lengthCodes[length - 2][0], lengthCodes[length - 2][1]);
+		} else {
+			int value = 8;
+			while (length >= 8 + (1U << (value - 6)))
+				++value;
+			writer.putBits(lengthCodes[value][0], lengthCodes[value][1]);
+			writer.putBits(length - 8 - (1 << (value - 7)), value - 7);
+		}
+
+		if (length == 519)
+			break;
+
+		const uint32 distance = offset - 1;
+		writer.putBits(distanceCodes[distance >> dictionaryType][0], distanceCodes[distance >> dictionaryType][1]);
+		writer.putBits(distance & ((1 << dictionaryType) - 1), dictionaryType);
+
+		for (uint32 i = 1; i < length; ++i)
+			finder.insert(pos + i);
+		pos += length;
+	}
+
+	writer.flush();
+}
+
+/**
+ * Encode data as a STACpack/LZS stream, as read by Sci::DecompressorLZS.
+ */
+inline void encodeLZS(const byte *data, uint32 size, Common::Array<byte> &out) {
+	BitWriter<true> writer(out);
+
+	MatchFinder finder(data, size, 2047, 2047);
+	uint32 pos = 0;
+	while (pos < size) {
+		uint32 offset = 0;
+		const uint32 length = finder.find(pos, offset);
+		if (length) {
+			if (offset < 128) {
+				writer.putBits(3, 2);
+				writer.putBits(offset, 7);
+			} else {
+				writer.putBits(2, 2);
+				writer.putBits(offset, 11);
+			}
+
+			if (length < 5) {
+				writer.putBits(length - 2, 2);
+			} else if (length < 8) {
+				writer.putBits(0xC | (length - 5), 4);
+			} else {
+				writer.putBits(0xF, 4);
+				uint32 rest = length - 8;
+				while (rest >= 15) {
+					writer.putBits(0xF, 4);
+					rest -= 15;
+				}
+				writer.putBits(rest, 4);
+			}
+
+			for (uint32 i = 1; i < length; ++i)
+				finder.insert(pos + i);
+			pos += length;
+		} else {
+			writer.putBits(0, 1);
+			writer.putBits(data[pos], 8);
+			++pos;
+		}
+	}
+
+	// End marker, a seven bit offset of zero
+	writer.putBits(3, 2);
+	writer.putBits(0, 7);
+	writer.flush();
+}
+
+} // End of namespace TestEncoders
+
+#endif
@@ -0,0 +1,165 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef POSIX
+#include "backends/fs/posix/posix-fs-factory.h"
+#include "backends/fs/stdiostream.h"
+#endif
+#ifdef HAVE_MMAP
+#include "backends/fs/posix/posix-mmapstream.h"
+#endif
+
+#include "common/ptr.h"
+
+/**
+ * Tests for POSIXMmapStream, which POSIXFilesystemNode uses for big game
+ * data files on hosts with mmap(), and for the fallback to stdio. The tests
+ * create their files in the current directory.
+ */
+class MmapStreamTestSuite : public CxxTest::TestSuite {
+#ifdef POSIX
+	static const char *bigFile() { return "mmapstream-big.tmp"; }
+	static const char *smallFile() { return "mmapstream-small.tmp"; }
+
+	static byte pattern(uint32 i) {
+		return (byte)(i * 7 + (i >> 8));
+	}
+
+	static bool createFile(const char *path, uint32 size) {
+		Common::ScopedPtr<StdioStream> file(StdioStream::makeFromPath(path, true));
+		if (!file)
+			return false;
+
+		byte buffer[4096];
+		for (uint32 pos = 0; pos < size; pos += sizeof(buffer)) {
+			const uint32 chunk = MIN<uint32>(sizeof(buffer), size - pos);
+			for (uint32 i = 0; i < chunk; ++i)
+				buffer[i] = pattern(pos + i);
+			if (file->write(buffer, chunk) != chunk)
+				return false;
+		}
+		return file->flush();
+	}
+
+	static AbstractFSNode *makeNode(const char *path) {
+		POSIXFilesystemFactory factory;
+		return static_cast<FilesystemFactory &>(factory).makeFileNodePath(path);
+	}
+#endif
+
+#ifdef HAVE_MMAP
+	enum {
+		kBigSize = POSIXMmapStream::kMinMappedFileSize + 1234
+	};
+#endif
+
+public:
+	void setUp() {
+#ifdef HAVE_MMAP
+		TS_ASSERT(createFile(bigFile(), kBigSize));
+#endif
+#ifdef POSIX
+		TS_ASSERT(createFile(smallFile(), 1000));
+#endif
+	}
+
+	void tearDown() {
+#ifdef POSIX
+		remove(bigFile());
+		remove(smallFile());
+#endif
+	}
+
+	void test_get_data() {
+#ifdef HAVE_MMAP
+		Common::ScopedPtr<POSIXMmapStream> stream(POSIXMmapStream::makeFromPath(bigFile()));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), (int32)kBigSize);
+		const byte *data = stream->getData();
+		TS_ASSERT(data);
+		bool same = true;
+		for (uint32 i = 0; i < kBigSize && same; ++i)
+			same = data[i] == pattern(i);
+		TS_ASSERT(same);
+
+		// Reading does not change what getData() returns
+		TS_ASSERT(stream->seek(5000));
+		TS_ASSERT_EQUALS(stream->readByte(), pattern(5000));
+		TS_ASSERT_EQUALS(stream->getData(), data);
+#endif
+	}
+
+	void test_seek_past_end() {
+#ifdef HAVE_MMAP
+		Common::ScopedPtr<POSIXMmapStream> stream(POSIXMmapStream::makeFromPath(bigFile()));
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		// Like fseek(), seeking past the end succeeds and the next read
+		// hits the end of the stream
+		TS_ASSERT(stream->seek(kBigSize + 100));
+		TS_ASSERT(!stream->eos());
+		byte buffer[4];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 0U);
+		TS_ASSERT(stream->eos());
+
+		TS_ASSERT(stream->seek(10, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 0U);
+		TS_ASSERT(stream->eos());
+
+		// Seeking back clears the end of stream flag
+		TS_ASSERT(stream->seek(-2, SEEK_END));
+		TS_ASSERT(!stream->eos());
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 2U);
+		TS_ASSERT_EQUALS(buffer[0], pattern(kBigSize - 2));
+		TS_ASSERT_EQUALS(buffer[1], pattern(kBigSize - 1));
+
+		// Seeking before the start fails
+		TS_ASSERT(!stream->seek(-1));
+		TS_ASSERT(!stream->seek(-(int32)kBigSize - 1, SEEK_END));
+#endif
+	}
+
+	void test_not_mapped() {
+#ifdef HAVE_MMAP
+		// Small files, directories and missing files are not mapped
+		TS_ASSERT(!POSIXMmapStream::makeFromPath(smallFile()));
+		TS_ASSERT(!POSIXMmapStream::makeFromPath("."));
+		TS_ASSERT(!POSIXMmapStream::makeFromPath("mmapstream-missing.tmp"));
+#endif
+	}
+
+	void test_data_stream_fallback() {
+#ifdef POSIX
+		// Files which are not mapped are read through stdio
+		Common::ScopedPtr<AbstractFSNode> small(makeNode(smallFile()));
+		Common::ScopedPtr<Common::SeekableReadStream> stream(small->createDataReadStream());
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), 1000);
+		TS_ASSERT(!stream->getData());
+		TS_ASSERT(stream->seek(999));
+		TS_ASSERT_EQUALS(stream->readByte(), pattern(999));
+#endif
+	}
+
+	void test_read_stream_not_mapped() {
+#ifdef HAVE_MMAP
+		// createReadStream(), which is also used for savegames, never maps
+		// files, only createDataReadStream() does
+		Common::ScopedPtr<AbstractFSNode> big(makeNode(bigFile()));
+		Common::ScopedPtr<Common::SeekableReadStream> stream(big->createReadStream());
+		TS_ASSERT(stream);
+		TS_ASSERT(stream && !stream->getData());
+
+		Common::ScopedPtr<Common::SeekableReadStream> dataStream(big->createDataReadStream());
+		TS_ASSERT(dataStream);
+		TS_ASSERT(dataStream && dataStream->getData());
+#endif
+	}
+};
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/unzip.h"
+
+/**
+ * Tests for the streams of zip archive members, in particular for members
+ * stored uncompressed in an archive whose data is accessible in memory.
+ */
+class ZipArchiveTestSuite : public CxxTest::TestSuite {
+	static uint32 crc32(const byte *data, uint32 size) {
+		uint32 crc = 0xFFFFFFFF;
+		for (uint32 i = 0; i < size; ++i) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; ++bit)
+				crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+		}
+		return ~crc;
+	}
+
+	/**
+	 * Build a zip archive with a single stored member, preceded by a local
+	 * header with an extra field, which the member data offset must skip.
+	 */
+	static Common::MemoryWriteStreamDynamic *makeArchive(const char *name, const byte *data, uint32 size) {
+		Common::MemoryWriteStreamDynamic *zip = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		const uint32 crc = crc32(data, size);
+		const uint16 nameLength = strlen(name);
+		const uint16 extraLength = 5;
+
+		// Local file header
+		zip->writeUint32LE(0x04034b50);
+		zip->writeUint16LE(10);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0); // stored
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(crc);
+		zip->writeUint32LE(size);
+		zip->writeUint32LE(size);
+		zip->writeUint16LE(nameLength);
+		zip->writeUint16LE(extraLength);
+		zip->write(name, nameLength);
+		zip->write("extra", extraLength);
+		zip->write(data, size);
+
+		// Central directory
+		const uint32 centralDirOffset = zip->pos();
+		zip->writeUint32LE(0x02014b50);
+		zip->writeUint16LE(20);
+		zip->writeUint16LE(10);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(crc);
+		zip->writeUint32LE(size);
+		zip->writeUint32LE(size);
+		zip->writeUint16LE(nameLength);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint32LE(0);
+		zip->writeUint32LE(0);
+		zip->write(name, nameLength);
+		const uint32 centralDirSize = zip->pos() - centralDirOffset;
+
+		// End of central directory
+		zip->writeUint32LE(0x06054b50);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(0);
+		zip->writeUint16LE(1);
+		zip->writeUint16LE(1);
+		zip->writeUint32LE(centralDirSize);
+		zip->writeUint32LE(centralDirOffset);
+		zip->writeUint16LE(0);
+
+		return zip;
+	}
+
+	static const byte *testData() {
+		return (const byte *)"The quick brown fox jumps over the lazy dog";
+	}
+
+	static uint32 testSize() {
+		return strlen((const char *)testData());
+	}
+
+	Common::Archive *openArchive(Common::MemoryWriteStreamDynamic *zip, bool shareStoredData) {
+		// The archive takes ownership of the stream, not of the data
+		return Common::makeZipArchive(new Common::MemoryReadStream(zip->getData(), zip->size()), shareStoredData);
+	}
+
+public:
+	void test_stored_member_copied() {
+		Common::ScopedPtr<Common::MemoryWriteStreamDynamic> zip(makeArchive("file.txt", testData(), testSize()));
+		Common::ScopedPtr<Common::Archive> archive(openArchive(zip.get(), false));
+		TS_ASSERT(archive);
+
+		Common::ScopedPtr<Common::SeekableReadStream> member(archive->createReadStreamForMember("file.txt"));
+		TS_ASSERT(member);
+		TS_ASSERT_EQUALS(member->size(), (int32)testSize());
+		TS_ASSERT(member->getData());
+		TS_ASSERT_EQUALS(memcmp(member->getData(), testData(), testSize()), 0);
+
+		// A copy of the data, not a pointer into the archive
+		const byte *archiveEnd = zip->getData() + zip->size();
+		TS_ASSERT(member->getData() < zip->getData() || member->getData() >= archiveEnd);
+	}
+
+	void test_stored_member_shared() {
+		Common::ScopedPtr<Common::MemoryWriteStreamDynamic> zip(makeArchive("file.txt", testData(), testSize()));
+		Common::ScopedPtr<Common::Archive> archive(openArchive(zip.get(), true));
+		TS_ASSERT(archive);
+
+		Common::ScopedPtr<Common::SeekableReadStream> member(archive->createReadStreamForMember("FILE.TXT"));
+		TS_ASSERT(member);
+		TS_ASSERT_EQUALS(member->size(), (int32)testSize());
+
+		// The data is read in place, after the local header and its extra field
+		TS_ASSERT_EQUALS(member->getData(), zip->getData() + 30 + strlen("file.txt") + strlen("extra"));
+		TS_ASSERT_EQUALS(memcmp(member->getData(), testData(), testSize()), 0);
+
+		byte buffer[9];
+		TS_ASSERT(member->seek(4));
+		TS_ASSERT_EQUALS(member->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_EQUALS(memcmp(buffer, "quick bro", sizeof(buffer)), 0);
+	}
+
+	void test_stored_member_truncated() {
+		Common::ScopedPtr<Common::MemoryWriteStreamDynamic> zip(makeArchive("file.txt", testData(), testSize()));
+
+		// Claim more data than the archive has
+		WRITE_LE_UINT32(zip->getData() + 18, 1000);
+		WRITE_LE_UINT32(zip->getData() + 22, 1000);
+		const uint32 centralDir = 30 + strlen("file.txt") + strlen("extra") + testSize();
+		WRITE_LE_UINT32(zip->getData() + centralDir + 20, 1000);
+		WRITE_LE_UINT32(zip->getData() + centralDir + 24, 1000);
+
+		Common::ScopedPtr<Common::Archive> archive(openArchive(zip.get(), true));
+		TS_ASSERT(archive);
+		TS_ASSERT(archive->hasFile("file.txt"));
+		TS_ASSERT(!archive->createReadStreamForMember("file.txt"));
+	}
+
+	void test_missing_member() {
+		Common::ScopedPtr<Common::MemoryWriteStreamDynamic> zip(makeArchive("file.txt", testData(), testSize()));
+		Common::ScopedPtr<Common::Archive> archive(openArchive(zip.get(), true));
+		TS_ASSERT(archive);
+		TS_ASSERT(!archive->createReadStreamForMember("other.txt"));
+	}
+};
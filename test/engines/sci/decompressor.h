@@ -0,0 +1,224 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "engines/sci/decompressor.h"
+
+#include "test/common/encoders.h"
+
+/**
+ * The STACpack/LZS decoder as it was before it was changed to decode from
+ * memory, reading the data bit by bit from a stream. Writes past the end of
+ * the target buffer and copies from before its start are reported as
+ * errors instead of corrupting memory.
+ */
+class ReferenceLZS {
+public:
+	ReferenceLZS(Common::ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked) :
+		_src(src), _dest(dest), _szPacked(nPacked), _szUnpacked(nUnpacked),
+		_dwBits(0), _nBits(0), _dwRead(0), _dwWrote(0) {}
+
+	bool unpack() {
+		while (!(_dwWrote == _szUnpacked && _dwRead >= _szPacked)) {
+			if (getBitsMSB(1)) {
+				uint32 offs;
+				if (getBitsMSB(1)) {
+					offs = getBitsMSB(7);
+					if (!offs)
+						break;
+				} else {
+					offs = getBitsMSB(11);
+				}
+
+				uint32 clen = getCompLen();
+				if (offs > _dwWrote)
+					return false;
+				while (clen--) {
+					if (!putByte(_dest[_dwWrote - offs]))
+						return false;
+				}
+			} else if (!putByte(getBitsMSB(8))) {
+				return false;
+			}
+		}
+		return _dwWrote == _szUnpacked;
+	}
+
+private:
+	uint32 getBitsMSB(int n) {
+		if (_nBits < n) {
+			while (_nBits <= 24) {
+				_dwBits |= ((uint32)_src->readByte()) << (24 - _nBits);
+				_nBits += 8;
+				_dwRead++;
+			}
+		}
+		uint32 ret = _dwBits >> (32 - n);
+		_dwBits <<= n;
+		_nBits -= n;
+		return ret;
+	}
+
+	uint32 getCompLen() {
+		switch (getBitsMSB(2)) {
+		case 0:
+			return 2;
+		case 1:
+			return 3;
+		case 2:
+			return 4;
+		default:
+			switch (getBitsMSB(2)) {
+			case 0:
+				return 5;
+			case 1:
+				return 6;
+			case 2:
+				return 7;
+			default:
+				uint32 clen = 8;
+				uint32 nibble;
+				do {
+					nibble = getBitsMSB(4);
+					clen += nibble;
+				} while (nibble == 0xf);
+				return clen;
+			}
+		}
+	}
+
+	bool putByte(byte b) {
+		if (_dwWrote == _szUnpacked)
+			return false;
+		_dest[_dwWrote++] = b;
+		return true;
+	}
+
+	Common::ReadStream *_src;
+	byte *_dest;
+	uint32 _szPacked;
+	uint32 _szUnpacked;
+	uint32 _dwBits;
+	int _nBits;
+	uint32 _dwRead;
+	uint32 _dwWrote;
+};
+
+class SciDecompressorTestSuite : public CxxTest::TestSuite {
+	uint32 _state;
+
+	uint32 nextRandom() {
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	/** Generate data with repetitions, like most game resources. */
+	void generate(Common::Array<byte> &data, uint32 size) {
+		data.resize(size);
+		for (uint32 i = 0; i < size; ) {
+			uint32 offset = nextRandom() % 2100 + 1;
+			uint32 length = nextRandom() % 80 + 1;
+			if (nextRandom() % 3 == 0 || offset > i) {
+				data[i++] = (nextRandom() % 4 == 0) ? nextRandom() : 'a' + nextRandom() % 8;
+			} else {
+				for (; length && i < size; --length, ++i)
+					data[i] = data[i - offset];
+			}
+		}
+	}
+
+	/**
+	 * Decompress with the LZS decompressor and the reference decoder. If
+	 * the reference decoder succeeds, the results have to be identical.
+	 */
+	bool decompressBoth(Sci::DecompressorLZS &lzs, const Common::Array<byte> &packed, Common::Array<byte> &unpacked, uint32 unpackedSize) {
+		// An eleven bit offset of zero copies the bytes which are about to
+		// be written, so start from identical buffers
+		unpacked.resize(unpackedSize);
+		memset(unpacked.begin(), 0, unpackedSize);
+		Common::MemoryReadStream src(packed.begin(), packed.size());
+		const bool success = lzs.unpack(&src, unpacked.begin(), packed.size(), unpackedSize) == 0;
+
+		Common::Array<byte> expected;
+		expected.resize(unpackedSize);
+		memset(expected.begin(), 0, unpackedSize);
+		Common::MemoryReadStream referenceSrc(packed.begin(), packed.size());
+		ReferenceLZS reference(&referenceSrc, expected.begin(), packed.size(), unpackedSize);
+		if (reference.unpack()) {
+			TS_ASSERT(success);
+			TS_ASSERT(expected == unpacked);
+		}
+		return success;
+	}
+
+public:
+	void setUp() {
+		_state = 0x2545F491;
+	}
+
+	void test_lzs_round_trip() {
+		static const uint32 sizes[] = { 1, 2, 3, 17, 600, 5000, 70000 };
+		// The same decompressor is reused, like for robot videos
+		Sci::DecompressorLZS lzs;
+		for (uint i = 0; i < ARRAYSIZE(sizes); ++i) {
+			Common::Array<byte> data, packed, unpacked;
+			generate(data, sizes[i]);
+			TestEncoders::encodeLZS(data.begin(), data.size(), packed);
+
+			TS_ASSERT(decompressBoth(lzs, packed, unpacked, data.size()));
+			TS_ASSERT(unpacked == data);
+		}
+	}
+
+	void test_lzs_long_runs() {
+		// Long matches which overlap the bytes they produce
+		Sci::DecompressorLZS lzs;
+		Common::Array<byte> data, packed, unpacked;
+		data.resize(5000);
+		memset(data.begin(), 'x', data.size());
+		data[3000] = 'y';
+		TestEncoders::encodeLZS(data.begin(), data.size(), packed);
+
+		TS_ASSERT(decompressBoth(lzs, packed, unpacked, data.size()));
+		TS_ASSERT(unpacked == data);
+	}
+
+	void test_lzs_size_mismatch() {
+		Sci::DecompressorLZS lzs;
+		Common::Array<byte> data, packed, unpacked;
+		generate(data, 1000);
+		TestEncoders::encodeLZS(data.begin(), data.size(), packed);
+
+		// Ends before the declared size is reached
+		TS_ASSERT(!decompressBoth(lzs, packed, unpacked, data.size() + 1));
+		// Matches beyond the declared size
+		TS_ASSERT(!decompressBoth(lzs, packed, unpacked, data.size() - 100));
+	}
+
+	void test_lzs_truncated() {
+		// Missing data reads as zeros, which decode to literal zero bytes
+		Sci::DecompressorLZS lzs;
+		Common::Array<byte> data, packed, unpacked;
+		generate(data, 2000);
+		TestEncoders::encodeLZS(data.begin(), data.size(), packed);
+
+		for (uint32 size = 0; size < packed.size(); size += 37) {
+			Common::Array<byte> truncated(packed.begin(), size);
+			decompressBoth(lzs, truncated, unpacked, data.size());
+		}
+	}
+
+	void test_lzs_random_streams() {
+		Sci::DecompressorLZS lzs;
+		for (int i = 0; i < 400; ++i) {
+			Common::Array<byte> packed, unpacked;
+			packed.resize(nextRandom() % 2000 + 1);
+			for (uint32 j = 0; j < packed.size(); ++j)
+				packed[j] = nextRandom();
+
+			decompressBoth(lzs, packed, unpacked, nextRandom() % 8000 + 1);
+		}
+	}
+};
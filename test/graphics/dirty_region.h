@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirty_region.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kWidth = 320,
+		kHeight = 200
+	};
+
+	/**
+	 * Check that the rects returned by the region do not overlap, and that
+	 * they cover all pixels in the given rects.
+	 */
+	void checkCoverage(const Graphics::DirtyRegion &region, const Common::Array<Common::Rect> &added) {
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+
+		byte *covered = new byte[kWidth * kHeight];
+		memset(covered, 0, kWidth * kHeight);
+		for (uint i = 0; i < rects.size(); ++i) {
+			const Common::Rect &r = rects[i];
+			TS_ASSERT(!r.isEmpty());
+			TS_ASSERT(r.left >= 0 && r.top >= 0 && r.right <= kWidth && r.bottom <= kHeight);
+			for (int y = r.top; y < r.bottom; ++y)
+				for (int x = r.left; x < r.right; ++x)
+					covered[y * kWidth + x]++;
+		}
+
+		int overlaps = 0, missing = 0;
+		for (int i = 0; i < kWidth * kHeight; ++i)
+			overlaps += covered[i] > 1;
+		for (uint i = 0; i < added.size(); ++i) {
+			Common::Rect r(added[i]);
+			r.clip(kWidth, kHeight);
+			for (int y = r.top; y < r.bottom; ++y)
+				for (int x = r.left; x < r.right; ++x)
+					missing += !covered[y * kWidth + x];
+		}
+		TS_ASSERT_EQUALS(overlaps, 0);
+		TS_ASSERT_EQUALS(missing, 0);
+
+		delete[] covered;
+	}
+
+public:
+	void test_empty() {
+		Graphics::DirtyRegion region;
+		region.setSize(kWidth, kHeight);
+		TS_ASSERT(region.isEmpty());
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT(rects.empty());
+
+		region.addRect(Common::Rect(kWidth, 0, kWidth + 10, 10));
+		region.addRect(Common::Rect(5, 5, 5, 10));
+		TS_ASSERT(region.isEmpty());
+	}
+
+	void test_single_rect() {
+		Graphics::DirtyRegion region;
+		region.setSize(kWidth, kHeight);
+
+		const Common::Rect r(8, 8, 40, 40);
+		region.addRect(r);
+		TS_ASSERT(!region.isEmpty());
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1U);
+		TS_ASSERT_EQUALS(rects[0], r);
+
+		region.clear();
+		TS_ASSERT(region.isEmpty());
+		region.getRects(rects);
+		TS_ASSERT(rects.empty());
+	}
+
+	void test_full_screen() {
+		Graphics::DirtyRegion region;
+		region.setSize(kWidth, kHeight);
+		region.addRect(Common::Rect(-10, -10, kWidth + 10, kHeight + 10));
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1U);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, kWidth, kHeight));
+	}
+
+	void test_overlapping_rects() {
+		Graphics::DirtyRegion region;
+		region.setSize(kWidth, kHeight);
+
+		Common::Array<Common::Rect> added;
+		added.push_back(Common::Rect(0, 0, 100, 50));
+		added.push_back(Common::Rect(50, 25, 150, 75));
+		added.push_back(Common::Rect(0, 0, 100, 50));
+		added.push_back(Common::Rect(300, 190, 330, 210));
+		for (uint i = 0; i < added.size(); ++i)
+			region.addRect(added[i]);
+
+		checkCoverage(region, added);
+	}
+
+	void test_many_small_rects() {
+		Graphics::DirtyRegion region;
+		region.setSize(kWidth, kHeight);
+
+		// Particles all over the screen. More rects than there are tiles
+		// must not result in more rects than tiles.
+		Common::Array<Common::Rect> added;
+		uint32 seed = 1;
+		for (int i = 0; i < 2000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const int x = (seed >> 8) % kWidth;
+			const int y = (seed >> 20) % kHeight;
+			added.push_back(Common::Rect(x, y, x + 3, y + 3));
+			region.addRect(added.back());
+		}
+
+		Common::Array<Common::Rect> rects;
+		region.getRects(rects);
+		const uint numTiles = ((kWidth + Graphics::DirtyRegion::kTileSize - 1) / Graphics::DirtyRegion::kTileSize)
+		                    * ((kHeight + Graphics::DirtyRegion::kTileSize - 1) / Graphics::DirtyRegion::kTileSize);
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), numTiles);
+
+		checkCoverage(region, added);
+	}
+
+	void test_set_size() {
+		Graphics::DirtyRegion region;
+		region.setSize(16, 16);
+		region.addRect(Common::Rect(0, 0, 16, 16));
+		region.setSize(kWidth, kHeight);
+		TS_ASSERT(region.isEmpty());
+		TS_ASSERT_EQUALS(region.getWidth(), kWidth);
+		TS_ASSERT_EQUALS(region.getHeight(), kHeight);
+	}
+};
@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transform_cache.h"
+
+class TransformCacheTestSuite : public CxxTest::TestSuite
+{
+private:
+	Graphics::Surface _source;
+
+	void createSource(int width, int height) {
+		_source.create(width, height, Graphics::TransparentSurface::getSupportedPixelFormat());
+		uint32 seed = 1;
+		for (int y = 0; y < height; ++y) {
+			uint32 *row = (uint32 *)_source.getBasePtr(0, y);
+			for (int x = 0; x < width; ++x) {
+				seed = seed * 1103515245 + 12345;
+				row[x] = seed;
+			}
+		}
+	}
+
+	static bool equalSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		if (a.w != b.w || a.h != b.h || a.format != b.format)
+			return false;
+		for (int y = 0; y < a.h; ++y) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void setUp() {
+		createSource(64, 48);
+	}
+
+	void tearDown() {
+		_source.free();
+	}
+
+	void test_scale_matches_transparent_surface() {
+		const Common::Rect srcRect(5, 7, 45, 37);
+		Graphics::TransparentSurface area;
+		area.copyFrom(_source.getSubArea(srcRect));
+
+		Graphics::TransformCache cache;
+		for (int filter = 0; filter < 2; ++filter) {
+			Graphics::TransparentSurface *expected;
+			if (filter == Graphics::FILTER_BILINEAR)
+				expected = area.scaleT<Graphics::FILTER_BILINEAR>(57, 21);
+			else
+				expected = area.scaleT<Graphics::FILTER_NEAREST>(57, 21);
+
+			const Graphics::TransparentSurface *result = cache.scale(this, _source, srcRect, 57, 21, (Graphics::TFilteringMode)filter);
+			TS_ASSERT(equalSurfaces(*result, *expected));
+
+			expected->free();
+			delete expected;
+		}
+
+		area.free();
+	}
+
+	void test_rotoscale_matches_transparent_surface() {
+		const Common::Rect srcRect(0, 0, 32, 32);
+		Graphics::TransparentSurface area;
+		area.copyFrom(_source.getSubArea(srcRect));
+
+		const Graphics::TransformStruct transform(150, 80, 30, 16, 16);
+		Graphics::TransparentSurface *expected = area.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+
+		Graphics::TransformCache cache;
+		const Graphics::TransparentSurface *result = cache.rotoscale(this, _source, srcRect, transform, Graphics::FILTER_BILINEAR);
+		TS_ASSERT(equalSurfaces(*result, *expected));
+
+		// Parameters which do not change the transformed pixels share the result
+		Graphics::TransformStruct faded(transform);
+		faded._rgbaMod = 0x80FFFFFF;
+		TS_ASSERT_EQUALS(cache.rotoscale(this, _source, srcRect, faded, Graphics::FILTER_BILINEAR), result);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 1u);
+
+		expected->free();
+		delete expected;
+		area.free();
+	}
+
+	void test_hits_and_misses() {
+		Graphics::TransformCache cache;
+		const Common::Rect srcRect(0, 0, 64, 48);
+
+		const Graphics::TransparentSurface *first = cache.scale(this, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.scale(this, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST), first);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 1u);
+
+		// Any difference in the parameters is a different result
+		cache.scale(this, _source, srcRect, 32, 24, Graphics::FILTER_BILINEAR);
+		cache.scale(this, _source, srcRect, 33, 24, Graphics::FILTER_NEAREST);
+		cache.scale(this, _source, Common::Rect(1, 0, 64, 48), 32, 24, Graphics::FILTER_NEAREST);
+		cache.scale(&cache, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 5u);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 5u);
+
+		cache.resetStats();
+		TS_ASSERT_EQUALS(cache.getStats().hits, 0u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 0u);
+	}
+
+	void test_invalidate() {
+		Graphics::TransformCache cache;
+		const Common::Rect srcRect(0, 0, 64, 48);
+		int otherId;
+
+		cache.scale(this, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		cache.scale(this, _source, srcRect, 16, 12, Graphics::FILTER_NEAREST);
+		cache.scale(&otherId, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+
+		// Change the source, and make sure the new contents are used
+		memset(_source.getPixels(), 0x55, _source.pitch * _source.h);
+		cache.invalidate(this);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 1u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 32u * 24 * 4);
+
+		const Graphics::TransparentSurface *result = cache.scale(this, _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(*(const uint32 *)result->getBasePtr(10, 10), 0x55555555u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 4u);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 0u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+	}
+
+	void test_memory_budget() {
+		const uint32 entrySize = 32 * 24 * 4;
+		Graphics::TransformCache cache(entrySize * 3);
+		const Common::Rect srcRect(0, 0, 64, 48);
+		int ids[4];
+
+		for (int i = 0; i < 3; ++i)
+			cache.scale(&ids[i], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), entrySize * 3);
+
+		// Use the oldest entry, so that the second one gets evicted next
+		cache.scale(&ids[0], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		cache.scale(&ids[3], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 3u);
+		TS_ASSERT_EQUALS(cache.getStats().evictions, 1u);
+
+		cache.scale(&ids[0], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		cache.scale(&ids[2], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 3u);
+		cache.scale(&ids[1], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 5u);
+
+		// A result larger than the budget is kept until the next request
+		cache.setMemoryBudget(entrySize / 2);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 0u);
+		const Graphics::TransparentSurface *result = cache.scale(&ids[0], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT(result != nullptr);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 1u);
+		cache.scale(&ids[1], _source, srcRect, 32, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getNumEntries(), 1u);
+	}
+};
@@ -0,0 +1,208 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kTargetWidth = 64,
+		kTargetHeight = 40,
+		// Not a multiple of four, so that partial groups are blended, too.
+		kSpriteWidth = 37,
+		kSpriteHeight = 13
+	};
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void fillRandom(Graphics::Surface &surface) {
+		for (int y = 0; y < surface.h; ++y) {
+			uint32 *row = (uint32 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; ++x) {
+				uint32 pixel = nextRandom() << 8 | (nextRandom() & 0xFF);
+				// Make sure the special alpha values occur often
+				switch (nextRandom() % 4) {
+				case 0:
+					pixel &= 0xFFFFFF00;
+					break;
+				case 1:
+					pixel |= 0xFF;
+					break;
+				default:
+					break;
+				}
+				row[x] = pixel;
+			}
+		}
+	}
+
+	/**
+	 * Plain reimplementation of blending a single pixel. Pixels are in the
+	 * format of TransparentSurface, that is with alpha in the lowest bits.
+	 */
+	static uint32 referenceBlend(uint32 src, uint32 dst, uint32 color, Graphics::TSpriteBlendMode mode) {
+		const uint32 a = src & 0xFF;
+		const uint32 ca = color >> 24;
+		const bool tinted = (color != 0xFFFFFFFF);
+		const uint32 ina = tinted ? a * ca >> 8 : a;
+
+		if (!tinted && a == 0)
+			return dst;
+
+		uint32 result = dst;
+		if (mode == Graphics::BLEND_NORMAL || (mode == Graphics::BLEND_SUBTRACTIVE && tinted))
+			result |= 0xFF;
+
+		for (int shift = 8; shift < 32; shift += 8) {
+			const uint32 s = (src >> shift) & 0xFF;
+			const uint32 d = (dst >> shift) & 0xFF;
+			const uint32 c = (color >> (shift - 8)) & 0xFF;
+
+			uint32 value;
+			switch (mode) {
+			case Graphics::BLEND_ADDITIVE:
+				value = d + (c != 255 ? s * c * ina >> 16 : s * ina >> 8);
+				break;
+			case Graphics::BLEND_SUBTRACTIVE:
+				if (!tinted || c == 255)
+					value = d - (s * d * a >> 16);
+				else
+					value = d - (s * c * d * a >> 24);
+				break;
+			case Graphics::BLEND_MULTIPLY:
+				value = d * (c != 255 ? s * c * ina >> 16 : s * ina >> 8) >> 8;
+				break;
+			default:
+				if (tinted)
+					value = (d * (255 - ina) >> 8) + (s * ina * c >> 16);
+				else
+					value = (s * a + d * (255 - a)) >> 8;
+				break;
+			}
+
+			result &= ~(0xFFU << shift);
+			result |= MIN<uint32>(value, 255) << shift;
+		}
+
+		return result;
+	}
+
+	void blitTestTemplate(Graphics::TSpriteBlendMode mode, uint32 color, int flipping) {
+		_seed = mode * 7 + flipping + color;
+
+		Graphics::TransparentSurface sprite;
+		sprite.create(kSpriteWidth, kSpriteHeight, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillRandom(sprite);
+
+		Graphics::Surface target, expected;
+		target.create(kTargetWidth, kTargetHeight, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillRandom(target);
+		expected.copyFrom(target);
+
+		// Partly off-screen, so that clipping is tested as well
+		const int posX = kTargetWidth - kSpriteWidth + 6;
+		const int posY = -3;
+
+		for (int y = 0; y < kSpriteHeight; ++y) {
+			for (int x = 0; x < kSpriteWidth; ++x) {
+				if (posX + x >= kTargetWidth || posY + y < 0)
+					continue;
+
+				const int srcX = (flipping & Graphics::FLIP_H) ? kSpriteWidth - 1 - x : x;
+				const int srcY = (flipping & Graphics::FLIP_V) ? kSpriteHeight - 1 - y : y;
+				const uint32 src = *(const uint32 *)sprite.getBasePtr(srcX, srcY);
+				uint32 *dst = (uint32 *)expected.getBasePtr(posX + x, posY + y);
+				*dst = referenceBlend(src, *dst, color, mode);
+			}
+		}
+
+		sprite.blit(target, posX, posY, flipping, nullptr, color, -1, -1, mode);
+
+		int mismatches = 0;
+		for (int y = 0; y < kTargetHeight; ++y)
+			mismatches += memcmp(target.getBasePtr(0, y), expected.getBasePtr(0, y), kTargetWidth * 4) != 0;
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		sprite.free();
+		target.free();
+		expected.free();
+	}
+
+	void blendModeTestTemplate(Graphics::TSpriteBlendMode mode) {
+		const uint32 colors[] = { 0xFFFFFFFF, 0x80FFFFFF, 0xFF40FF90, 0xC0FF00FF, 0x01020304 };
+		const int flippings[] = { Graphics::FLIP_NONE, Graphics::FLIP_H, Graphics::FLIP_V, Graphics::FLIP_HV };
+
+		for (uint i = 0; i < ARRAYSIZE(colors); ++i)
+			for (uint j = 0; j < ARRAYSIZE(flippings); ++j)
+				blitTestTemplate(mode, colors[i], flippings[j]);
+	}
+
+	void blitClipTestTemplate(int flipping, int width, int height) {
+		_seed = flipping * 13 + width + height;
+
+		Graphics::TransparentSurface sprite;
+		sprite.create(kSpriteWidth, kSpriteHeight, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillRandom(sprite);
+
+		Graphics::Surface expected, target;
+		expected.create(kTargetWidth, kTargetHeight, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillRandom(expected);
+		target.copyFrom(expected);
+
+		Common::Rect partRect(3, 2, kSpriteWidth - 5, kSpriteHeight - 1);
+		const int posX = -4;
+		const int posY = 5;
+		const uint32 color = 0xC0FF40FF;
+		sprite.blit(expected, posX, posY, flipping, &partRect, color, width, height);
+
+		// Drawing the sprite tile by tile gives the same result
+		const int tileWidth = 7;
+		const int tileHeight = 5;
+		for (int y = 0; y < kTargetHeight; y += tileHeight) {
+			for (int x = 0; x < kTargetWidth; x += tileWidth) {
+				Common::Rect tile(x, y, MIN<int>(x + tileWidth, kTargetWidth), MIN<int>(y + tileHeight, kTargetHeight));
+				sprite.blitClip(target, tile, posX, posY, flipping, &partRect, color, width, height);
+			}
+		}
+
+		int mismatches = 0;
+		for (int y = 0; y < kTargetHeight; ++y)
+			mismatches += memcmp(target.getBasePtr(0, y), expected.getBasePtr(0, y), kTargetWidth * 4) != 0;
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		sprite.free();
+		target.free();
+		expected.free();
+	}
+
+public:
+	void test_blit_alpha() {
+		blendModeTestTemplate(Graphics::BLEND_NORMAL);
+	}
+
+	void test_blit_additive() {
+		blendModeTestTemplate(Graphics::BLEND_ADDITIVE);
+	}
+
+	void test_blit_subtractive() {
+		blendModeTestTemplate(Graphics::BLEND_SUBTRACTIVE);
+	}
+
+	void test_blit_multiply() {
+		blendModeTestTemplate(Graphics::BLEND_MULTIPLY);
+	}
+
+	void test_blit_clip() {
+		const int flippings[] = { Graphics::FLIP_NONE, Graphics::FLIP_H, Graphics::FLIP_V, Graphics::FLIP_HV };
+
+		for (uint i = 0; i < ARRAYSIZE(flippings); ++i) {
+			blitClipTestTemplate(flippings[i], -1, -1);
+			blitClipTestTemplate(flippings[i], 45, 20);
+		}
+	}
+};
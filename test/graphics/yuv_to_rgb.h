@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		// Not a multiple of eight, so that partial groups are converted, too.
+		kWidth = 44,
+		kHeight = 12,
+		kYPitch = 50,
+		kUVPitch = 30
+	};
+
+	uint32 _seed;
+	byte _y[kYPitch * kHeight];
+	byte _u[kUVPitch * (kHeight + 1)];
+	byte _v[kUVPitch * (kHeight + 1)];
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void fillPlanes() {
+		// Include the extremes, which need clamping
+		for (int i = 0; i < kYPitch * kHeight; ++i)
+			_y[i] = (nextRandom() % 4 == 0) ? ((nextRandom() & 1) ? 255 : 0) : (byte)nextRandom();
+		for (int i = 0; i < kUVPitch * (kHeight + 1); ++i) {
+			_u[i] = (nextRandom() % 4 == 0) ? ((nextRandom() & 1) ? 255 : 0) : (byte)nextRandom();
+			_v[i] = (nextRandom() % 4 == 0) ? ((nextRandom() & 1) ? 255 : 0) : (byte)nextRandom();
+		}
+	}
+
+	static uint8 referenceChannel(int value, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		if (scale == Graphics::YUVToRGBManager::kScaleFull)
+			return CLIP(value, 0, 255);
+
+		return (CLIP(value, 16, 235) - 16) * 255 / 219;
+	}
+
+	/** Plain reimplementation of the conversion of a single pixel. */
+	static uint32 referencePixel(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, byte y, byte u, byte v) {
+		const int cr = v - 128;
+		const int cb = u - 128;
+		const int r = y + (int16)((0.419 / 0.299) * cr);
+		const int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		const int b = y + (int16)((0.587 / 0.331) * cb);
+
+		return format.RGBToColor(referenceChannel(r, scale), referenceChannel(g, scale), referenceChannel(b, scale));
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	void convertTestTemplate(int subsampling, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		_seed = subsampling * 100 + format.bytesPerPixel * 10 + format.rShift + scale;
+		fillPlanes();
+
+		Graphics::Surface surface;
+		surface.create(kWidth + 3, kHeight, format);
+		memset(surface.getPixels(), 0xAB, surface.pitch * surface.h);
+
+		switch (subsampling) {
+		case 444:
+			YUVToRGBMan.convert444(&surface, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+			break;
+		case 420:
+			YUVToRGBMan.convert420(&surface, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+			break;
+		default:
+			YUVToRGBMan.convert410(&surface, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+			break;
+		}
+
+		const uint32 untouched = (format.bytesPerPixel == 2) ? 0xABAB : 0xABABABAB;
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth + 3; ++x) {
+				uint32 expected = untouched;
+
+				if (x < kWidth) {
+					const byte luma = _y[y * kYPitch + x];
+					byte u, v;
+
+					if (subsampling == 444) {
+						u = _u[y * kUVPitch + x];
+						v = _v[y * kUVPitch + x];
+					} else if (subsampling == 420) {
+						u = _u[(y / 2) * kUVPitch + x / 2];
+						v = _v[(y / 2) * kUVPitch + x / 2];
+					} else {
+						const int index = (y / 4) * kUVPitch + x / 4;
+						const int xDiff = x & 3, yDiff = y & 3;
+						u = (_u[index] * (4 - xDiff) * (4 - yDiff) + _u[index + 1] * xDiff * (4 - yDiff) +
+						     _u[index + kUVPitch] * yDiff * (4 - xDiff) + _u[index + kUVPitch + 1] * xDiff * yDiff) >> 4;
+						v = (_v[index] * (4 - xDiff) * (4 - yDiff) + _v[index + 1] * xDiff * (4 - yDiff) +
+						     _v[index + kUVPitch] * yDiff * (4 - xDiff) + _v[index + kUVPitch + 1] * xDiff * yDiff) >> 4;
+					}
+
+					expected = referencePixel(format, scale, luma, u, v);
+				}
+
+				TS_ASSERT_EQUALS(getPixel(surface, x, y), expected);
+			}
+		}
+
+		surface.free();
+	}
+
+	void convertAllFormats(int subsampling) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 0, 4, 8, 12),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			// Red straddles the two 16 bit halves of the pixel
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 10, 2, 18, 0)
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i) {
+			convertTestTemplate(subsampling, formats[i], Graphics::YUVToRGBManager::kScaleFull);
+			convertTestTemplate(subsampling, formats[i], Graphics::YUVToRGBManager::kScaleITU);
+		}
+	}
+
+public:
+	void test_convert444() {
+		convertAllFormats(444);
+	}
+
+	void test_convert420() {
+		convertAllFormats(420);
+	}
+
+	void test_convert410() {
+		convertAllFormats(410);
+	}
+};
@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+
+#include "image/codecs/indeo/indeo_dsp.h"
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		// Not a multiple of 16, so that partial groups are output, too.
+		kWidth = 86,
+		kHeight = 10,
+		kBandPitch = 48,
+		kDstPitch = 90
+	};
+
+	uint32 _seed;
+	int16 _coeffs[4][kBandPitch * (kHeight / 2)];
+	Image::Indeo::IVIBandDesc _bands[4];
+	Image::Indeo::IVIPlaneDesc _plane;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/**
+	 * Fill the bands with coefficients, mostly small ones like in real
+	 * videos, but also extremes, which need clipping.
+	 */
+	void setUpPlane(int width, int height) {
+		for (int b = 0; b < 4; b++) {
+			for (int i = 0; i < kBandPitch * (kHeight / 2); i++) {
+				switch (nextRandom() % 4) {
+				case 0:
+					_coeffs[b][i] = (int16)nextRandom();
+					break;
+				case 1:
+					_coeffs[b][i] = (nextRandom() & 1) ? 32767 : -32768;
+					break;
+				default:
+					_coeffs[b][i] = (int16)(nextRandom() % 512) - 256;
+					break;
+				}
+			}
+
+			_bands[b]._buf = _coeffs[b];
+			_bands[b]._pitch = kBandPitch;
+		}
+
+		_plane._width = width;
+		_plane._height = height;
+		_plane._numBands = 4;
+		_plane._bands = _bands;
+	}
+
+	static uint8 clip(int value) {
+		return (uint8)CLIP(value, 0, 255);
+	}
+
+	/** Coefficient of a band, with the rows and columns repeated at the edges. */
+	int coeff(int band, int row, int column) const {
+		row = CLIP(row, 0, (_plane._height + 1) / 2 - 1);
+		column = CLIP(column, 0, (_plane._width + 1) / 2 - 1);
+		return _coeffs[band][row * kBandPitch + column];
+	}
+
+	/** Vertical high pass of a band at the given position. */
+	int highPass(int band, int row, int column) const {
+		return coeff(band, row - 1, column) - 6 * coeff(band, row, column) + coeff(band, row + 1, column);
+	}
+
+	/** Plain reimplementation of the 5/3 recomposition of one pixel. */
+	uint8 reference53(int x, int y) const {
+		const int i = x / 2, j = y / 2;
+		int p;
+
+		if ((y & 1) == 0) {
+			if ((x & 1) == 0) {
+				p = (coeff(0, j, i) << 4) +
+				    ((coeff(1, j, i) + coeff(1, j - 1, i)) << 3) +
+				    ((coeff(2, j, i - 1) + coeff(2, j, i)) << 3) +
+				    ((coeff(3, j - 1, i - 1) + coeff(3, j, i - 1) + coeff(3, j - 1, i) + coeff(3, j, i)) << 2);
+			} else {
+				p = ((coeff(0, j, i) + coeff(0, j, i + 1)) << 3) +
+				    ((coeff(1, j, i) + coeff(1, j - 1, i) + coeff(1, j - 1, i + 1) + coeff(1, j, i + 1)) << 2) +
+				    ((coeff(2, j, i - 1) - 6 * coeff(2, j, i) + coeff(2, j, i + 1)) << 2) +
+				    ((coeff(3, j - 1, i - 1) + coeff(3, j, i - 1) - 6 * (coeff(3, j - 1, i) + coeff(3, j, i)) +
+				      coeff(3, j - 1, i + 1) + coeff(3, j, i + 1)) << 1);
+			}
+		} else {
+			// The HL-band adds its vertical high pass to that of the row
+			// above, as the original decoder does
+			const int hl = coeff(1, j - 1, i) - 6 * coeff(1, j, i) + highPass(1, j, i);
+
+			if ((x & 1) == 0) {
+				p = ((coeff(0, j, i) + coeff(0, j + 1, i)) << 3) +
+				    (hl << 2) +
+				    ((coeff(2, j, i - 1) + coeff(2, j, i) + coeff(2, j + 1, i - 1) + coeff(2, j + 1, i)) << 2) +
+				    ((highPass(3, j, i - 1) + highPass(3, j, i)) << 1);
+			} else {
+				p = ((coeff(0, j, i) + coeff(0, j, i + 1) + coeff(0, j + 1, i) + coeff(0, j + 1, i + 1)) << 2) +
+				    ((hl + highPass(1, j, i + 1)) << 1) +
+				    ((coeff(2, j, i - 1) - 6 * coeff(2, j, i) + coeff(2, j, i + 1) +
+				      coeff(2, j + 1, i - 1) - 6 * coeff(2, j + 1, i) + coeff(2, j + 1, i + 1)) << 1) +
+				    highPass(3, j, i - 1) - 6 * highPass(3, j, i) + highPass(3, j, i + 1);
+			}
+		}
+
+		return clip((p >> 6) + 128);
+	}
+
+public:
+	void test_output_plane() {
+		_seed = 1;
+		setUpPlane(kWidth, kHeight / 2);
+
+		byte dst[kDstPitch * kHeight];
+		memset(dst, 0xAB, sizeof(dst));
+		Image::Indeo::IndeoDSP::ffIviOutputPlane(&_plane, dst, kDstPitch);
+
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kDstPitch; x++) {
+				const bool inside = y < kHeight / 2 && x < kWidth;
+				const uint8 expected = inside ? clip(_coeffs[0][y * kBandPitch + x] + 128) : 0xAB;
+				TS_ASSERT_EQUALS(dst[y * kDstPitch + x], expected);
+			}
+		}
+	}
+
+	void test_recompose_haar() {
+		_seed = 2;
+		setUpPlane(kWidth, kHeight);
+
+		byte dst[kDstPitch * kHeight];
+		memset(dst, 0xAB, sizeof(dst));
+		Image::Indeo::IndeoDSP::ffIviRecomposeHaar(&_plane, dst, kDstPitch);
+
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kDstPitch; x++) {
+				uint8 expected = 0xAB;
+
+				if (x < kWidth) {
+					const int index = (y / 2) * kBandPitch + x / 2;
+					const int b0 = _coeffs[0][index];
+					const int b1 = (y & 1) ? -_coeffs[1][index] : _coeffs[1][index];
+					const int b2 = (x & 1) ? -_coeffs[2][index] : _coeffs[2][index];
+					const int b3 = ((x ^ y) & 1) ? -_coeffs[3][index] : _coeffs[3][index];
+					expected = clip(((b0 + b1 + b2 + b3 + 2) >> 2) + 128);
+				}
+
+				TS_ASSERT_EQUALS(dst[y * kDstPitch + x], expected);
+			}
+		}
+	}
+
+	void test_recompose53() {
+		_seed = 3;
+		// Also cover planes narrower than a group of blocks
+		const int widths[] = { kWidth, 20, 4, 2 };
+
+		for (uint w = 0; w < ARRAYSIZE(widths); w++) {
+			setUpPlane(widths[w], kHeight);
+
+			byte dst[kDstPitch * kHeight];
+			memset(dst, 0xAB, sizeof(dst));
+			Image::Indeo::IndeoDSP::ffIviRecompose53(&_plane, dst, kDstPitch);
+
+			for (int y = 0; y < kHeight; y++) {
+				for (int x = 0; x < kDstPitch; x++) {
+					const uint8 expected = (x < widths[w]) ? reference53(x, y) : 0xAB;
+					TS_ASSERT_EQUALS(dst[y * kDstPitch + x], expected);
+				}
+			}
+		}
+	}
+};
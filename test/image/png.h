@@ -0,0 +1,135 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "graphics/surface.h"
+#include "image/png.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kWidth = 23,
+		kHeight = 17
+	};
+
+	byte *_data;
+	uint32 _size;
+
+	/** Encode a test image, or return false without PNG support. */
+	bool createImage(bool alpha) {
+		// PNGs are written from RGBA, or RGB without alpha
+		const Graphics::PixelFormat format = alpha ? Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24) :
+		                                             Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0);
+		Graphics::Surface image;
+		image.create(kWidth, kHeight, format);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				byte *pixel = (byte *)image.getBasePtr(x, y);
+				pixel[0] = x * 11;
+				pixel[1] = y * 15;
+				pixel[2] = (x ^ y) * 7;
+				if (alpha)
+					pixel[3] = (x * y) & 0xFF;
+			}
+		}
+
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::NO);
+		const bool written = Image::writePNG(stream, image);
+		image.free();
+
+		_data = stream.getData();
+		_size = stream.size();
+		return written;
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	/** Return a color as 32 bit ARGB, ignoring the unused bits of its format. */
+	static uint32 toARGB(const Graphics::PixelFormat &format, uint32 color) {
+		byte a, r, g, b;
+		format.colorToARGB(color, a, r, g, b);
+		return (a << 24) | (r << 16) | (g << 8) | b;
+	}
+
+	/** Check that part of the full image ended up at the top left of surface. */
+	void checkArea(const Graphics::Surface &full, const Graphics::Surface &surface, const Common::Rect &area) {
+		for (int y = 0; y < area.height(); y++) {
+			for (int x = 0; x < area.width(); x++) {
+				byte a, r, g, b;
+				full.format.colorToARGB(getPixel(full, area.left + x, area.top + y), a, r, g, b);
+
+				const uint32 expected = toARGB(surface.format, surface.format.ARGBToColor(a, r, g, b));
+				TS_ASSERT_EQUALS(toARGB(surface.format, getPixel(surface, x, y)), expected);
+			}
+		}
+	}
+
+	void decodeTestTemplate(bool alpha) {
+		if (!createImage(alpha)) {
+			free(_data);
+			return;
+		}
+
+		Common::MemoryReadStream stream(_data, _size, DisposeAfterUse::YES);
+		Image::PNGDecoder full;
+		TS_ASSERT(full.loadStream(stream));
+		TS_ASSERT_EQUALS(full.getSurface()->w, kWidth);
+		TS_ASSERT_EQUALS(full.getSurface()->h, kHeight);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				byte a, r, g, b;
+				full.getSurface()->format.colorToARGB(getPixel(*full.getSurface(), x, y), a, r, g, b);
+				TS_ASSERT_EQUALS(r, (byte)(x * 11));
+				TS_ASSERT_EQUALS(g, (byte)(y * 15));
+				TS_ASSERT_EQUALS(b, (byte)((x ^ y) * 7));
+				TS_ASSERT_EQUALS(a, alpha ? (byte)(x * y) : 0xFF);
+			}
+		}
+
+		// A clipped area in another format
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Common::Rect clip(3, 5, 14, 11);
+		Image::PNGDecoder clipped;
+		clipped.setOutputPixelFormat(rgb565);
+		clipped.setClipRect(clip);
+		stream.seek(0);
+		TS_ASSERT(clipped.loadStream(stream));
+		TS_ASSERT_EQUALS(clipped.getSurface()->format, rgb565);
+		TS_ASSERT_EQUALS(clipped.getSurface()->w, clip.width());
+		TS_ASSERT_EQUALS(clipped.getSurface()->h, clip.height());
+		checkArea(*full.getSurface(), *clipped.getSurface(), clip);
+
+		// A clip rect reaching out of the image is clipped to it
+		Image::PNGDecoder bottom;
+		bottom.setClipRect(Common::Rect(0, 12, 100, 100));
+		stream.seek(0);
+		TS_ASSERT(bottom.loadStream(stream));
+		TS_ASSERT_EQUALS(bottom.getSurface()->w, kWidth);
+		TS_ASSERT_EQUALS(bottom.getSurface()->h, kHeight - 12);
+		checkArea(*full.getSurface(), *bottom.getSurface(), Common::Rect(0, 12, kWidth, kHeight));
+
+		// Straight into a smaller surface of a caller
+		const Graphics::PixelFormat abgr8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		Graphics::Surface target;
+		target.create(kWidth - 4, kHeight - 2, abgr8888);
+		Image::PNGDecoder into;
+		stream.seek(0);
+		TS_ASSERT(into.loadStreamInto(stream, target));
+		checkArea(*full.getSurface(), target, Common::Rect(kWidth - 4, kHeight - 2));
+		target.free();
+	}
+
+public:
+	void test_decode_alpha() {
+		decodeTestTemplate(true);
+	}
+
+	void test_decode_opaque() {
+		decodeTestTemplate(false);
+	}
+};
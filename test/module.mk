@@ -5,14 +5,35 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h \
+                $(srcdir)/test/image/*.h
+TEST_LIBS    := audio/libaudio.a image/libimage.a graphics/libgraphics.a common/libcommon.a
+
+ifdef USE_BINK
+	TESTS += $(srcdir)/test/video/*.h
+	TEST_LIBS += video/libvideo.a
+endif
+
+ifdef POSIX
+	TEST_LIBS := backends/fs/posix/posix-fs-factory.o backends/fs/posix/posix-fs.o \
+	             backends/fs/stdiostream.o $(TEST_LIBS)
+ifdef HAVE_MMAP
+	TEST_LIBS := backends/fs/posix/posix-mmapstream.o $(TEST_LIBS)
+endif
+endif
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+ifeq ($(ENABLE_SCI), STATIC_PLUGIN)
+ifdef ENABLE_SCI32
+	TESTS += $(srcdir)/test/engines/sci/*.h
+	TEST_LIBS += engines/sci/libsci.a
+endif
+endif
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
 TEST_CFLAGS  := $(CFLAGS) -I$(srcdir)/test/cxxtest
@@ -49,8 +70,41 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+#
+# Micro-benchmarks for performance critical code. Use the 'benchmark'
+# target to run them; pass e.g. BENCHMARK_FLAGS=--filter=hashmap to only
+# run some of them. For meaningful numbers, configure with
+# --enable-optimizations.
+#
+BENCHMARKS     := $(srcdir)/test/benchmark/runner.cpp $(srcdir)/test/benchmark/common/*.cpp \
+                  $(srcdir)/test/benchmark/audio/*.cpp \
+                  $(srcdir)/test/benchmark/graphics/*.cpp \
+                  $(srcdir)/test/benchmark/image/*.cpp \
+                  $(srcdir)/test/benchmark/video/*.cpp
+BENCHMARK_LIBS := audio/libaudio.a image/libimage.a graphics/libgraphics.a common/libcommon.a
+
+BENCHMARK_DEFINES :=
+
+ifdef USE_BINK
+BENCHMARK_LIBS := video/libvideo.a $(BENCHMARK_LIBS)
+endif
+
+ifeq ($(ENABLE_SCI), STATIC_PLUGIN)
+ifdef ENABLE_SCI32
+BENCHMARKS += $(srcdir)/test/benchmark/engines/sci/*.cpp
+BENCHMARK_LIBS := engines/sci/libsci.a $(BENCHMARK_LIBS)
+BENCHMARK_DEFINES += -DBENCHMARK_SCI
+endif
+endif
+
+benchmark: test/benchmark/runner
+	./test/benchmark/runner $(BENCHMARK_FLAGS)
+test/benchmark/runner: $(BENCHMARKS) $(BENCHMARK_LIBS)
+	@mkdir -p test/benchmark
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) $(BENCHMARK_DEFINES) -o $@ $+ $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/benchmark/runner
 
-.PHONY: test clean-test
+.PHONY: test benchmark clean-test
@@ -0,0 +1,207 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/bink_dsp.h"
+
+class BinkDSPTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kPitch = 40,
+		kBlocks = 300
+	};
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/**
+	 * Fill a block with random coefficients. Depending on the index, the
+	 * block is sparse like most real ones, has only DC values in some
+	 * columns, or uses the whole value range.
+	 */
+	void fillBlock(int16 *block, int index) {
+		for (int i = 0; i < 64; i++) {
+			switch (index % 4) {
+			case 0:
+				block[i] = (nextRandom() % 8 == 0) ? (int16)(nextRandom() % 512) - 256 : 0;
+				break;
+			case 1:
+				block[i] = (i < 8 && nextRandom() % 2) ? (int16)(nextRandom() % 4096) - 2048 : 0;
+				break;
+			case 2:
+				block[i] = (int16)(nextRandom() % 2048) - 1024;
+				break;
+			default:
+				block[i] = (int16)nextRandom();
+				break;
+			}
+		}
+	}
+
+	void fillPlane(byte *plane) {
+		for (int i = 0; i < kPitch * 16; i++)
+			plane[i] = (byte)nextRandom();
+	}
+
+	/** Plain reimplementation of one pass of the inverse DCT. */
+	static void referenceTransform(const int16 *src, int step, int *dst) {
+		const int a0 = src[0 * step] + src[4 * step];
+		const int a1 = src[0 * step] - src[4 * step];
+		const int a2 = src[2 * step] + src[6 * step];
+		const int a3 = (2896 * (src[2 * step] - src[6 * step])) >> 11;
+		const int a4 = src[5 * step] + src[3 * step];
+		const int a5 = src[5 * step] - src[3 * step];
+		const int a6 = src[1 * step] + src[7 * step];
+		const int a7 = src[1 * step] - src[7 * step];
+		const int b0 = a4 + a6;
+		const int b1 = (3784 * (a5 + a7)) >> 11;
+		const int b2 = ((-5352 * a5) >> 11) - b0 + b1;
+		const int b3 = ((2896 * (a6 - a4)) >> 11) - b2;
+		const int b4 = ((2217 * a7) >> 11) + b3 - b1;
+
+		dst[0] = a0 + a2 + b0;
+		dst[1] = a1 + a3 - a2 + b2;
+		dst[2] = a1 - a3 + a2 + b3;
+		dst[3] = a0 - a2 - b4;
+		dst[4] = a0 - a2 + b4;
+		dst[5] = a1 - a3 + a2 - b3;
+		dst[6] = a1 + a3 - a2 - b2;
+		dst[7] = a0 + a2 - b0;
+	}
+
+	static void referenceIDCT(int16 *block) {
+		int16 temp[64];
+		int out[8];
+
+		for (int i = 0; i < 8; i++) {
+			referenceTransform(block + i, 8, out);
+			for (int j = 0; j < 8; j++)
+				temp[j * 8 + i] = (int16)out[j];
+		}
+
+		for (int i = 0; i < 8; i++) {
+			referenceTransform(temp + i * 8, 1, out);
+			for (int j = 0; j < 8; j++)
+				block[i * 8 + j] = (int16)((out[j] + 0x7F) >> 8);
+		}
+	}
+
+	static void referenceAdd(byte *dest, const int16 *block) {
+		for (int i = 0; i < 8; i++)
+			for (int j = 0; j < 8; j++)
+				dest[i * kPitch + j] += block[i * 8 + j];
+	}
+
+	static void referenceScale(byte *dest, const int16 *block) {
+		for (int i = 0; i < 16; i++)
+			for (int j = 0; j < 16; j++)
+				dest[i * kPitch + j] = (byte)block[(i / 2) * 8 + j / 2];
+	}
+
+public:
+	void test_idct() {
+		_seed = 1;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 block[64], expected[64];
+			fillBlock(block, n);
+			memcpy(expected, block, sizeof(block));
+
+			referenceIDCT(expected);
+			Video::binkIDCT(block);
+			TS_ASSERT_EQUALS(memcmp(block, expected, sizeof(block)), 0);
+		}
+	}
+
+	void test_idct_put() {
+		_seed = 2;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 block[64], transformed[64];
+			byte plane[kPitch * 16], expected[kPitch * 16];
+			fillBlock(block, n);
+			fillPlane(plane);
+			memcpy(expected, plane, sizeof(plane));
+
+			memcpy(transformed, block, sizeof(block));
+			referenceIDCT(transformed);
+			for (int i = 0; i < 8; i++)
+				for (int j = 0; j < 8; j++)
+					expected[i * kPitch + 3 + j] = (byte)transformed[i * 8 + j];
+
+			Video::binkIDCTPut(plane + 3, kPitch, block);
+			TS_ASSERT_EQUALS(memcmp(plane, expected, sizeof(plane)), 0);
+		}
+	}
+
+	void test_idct_add() {
+		_seed = 3;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 block[64], transformed[64];
+			byte plane[kPitch * 16], expected[kPitch * 16];
+			fillBlock(block, n);
+			fillPlane(plane);
+			memcpy(expected, plane, sizeof(plane));
+
+			memcpy(transformed, block, sizeof(block));
+			referenceIDCT(transformed);
+			referenceAdd(expected + 5, transformed);
+
+			Video::binkIDCTAdd(plane + 5, kPitch, block);
+			TS_ASSERT_EQUALS(memcmp(plane, expected, sizeof(plane)), 0);
+		}
+	}
+
+	void test_idct_put_scaled() {
+		_seed = 4;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 block[64], transformed[64];
+			byte plane[kPitch * 16], expected[kPitch * 16];
+			fillBlock(block, n);
+			fillPlane(plane);
+			memcpy(expected, plane, sizeof(plane));
+
+			memcpy(transformed, block, sizeof(block));
+			referenceIDCT(transformed);
+			referenceScale(expected + 7, transformed);
+
+			Video::binkIDCTPutScaled(plane + 7, kPitch, block);
+			TS_ASSERT_EQUALS(memcmp(plane, expected, sizeof(plane)), 0);
+		}
+	}
+
+	void test_add_residue() {
+		_seed = 5;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 block[64];
+			byte plane[kPitch * 16], expected[kPitch * 16];
+			fillBlock(block, n);
+			fillPlane(plane);
+			memcpy(expected, plane, sizeof(plane));
+
+			referenceAdd(expected + 1, block);
+
+			Video::binkAddResidue(plane + 1, kPitch, block);
+			TS_ASSERT_EQUALS(memcmp(plane, expected, sizeof(plane)), 0);
+		}
+	}
+
+	void test_put_scaled() {
+		_seed = 6;
+		for (int n = 0; n < kBlocks; n++) {
+			int16 values[64];
+			byte pixels[64];
+			byte plane[kPitch * 16], expected[kPitch * 16];
+			for (int i = 0; i < 64; i++)
+				values[i] = pixels[i] = (byte)nextRandom();
+			fillPlane(plane);
+			memcpy(expected, plane, sizeof(plane));
+
+			referenceScale(expected + 2, values);
+
+			Video::binkPutScaled(plane + 2, kPitch, pixels);
+			TS_ASSERT_EQUALS(memcmp(plane, expected, sizeof(plane)), 0);
+		}
+	}
+};
@@ -0,0 +1,330 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Based on eos' Bink decoder which is in turn
+// based quite heavily on the Bink decoder found in FFmpeg.
+// Many thanks to Kostya Shishkov for doing the hard work.
+
+#include "video/bink_dsp.h"
+
+#if defined(__SSE2__)
+#define USE_SSE2_BINK_DSP
+#include <emmintrin.h>
+#endif
+
+namespace Video {
+
+#define A1  2896 /* (1/sqrt(2))<<12 */
+#define A2  2217
+#define A3  3784
+#define A4 -5352
+
+#ifdef USE_SSE2_BINK_DSP
+
+// The SSE2 transform works on all eight rows (or columns) of a block at
+// once, holding the samples at the same position of each in one vector.
+// Interleaving two of those vectors lets _mm_madd_epi16 compute the sums
+// and products of the C version exactly, in 32 bits per lane.
+
+static inline __m128i madd(__m128i pair, int16 f0, int16 f1) {
+	return _mm_madd_epi16(pair, _mm_set1_epi32((uint16)f0 | ((uint32)(uint16)f1 << 16)));
+}
+
+/**
+ * Transform four lanes, given as interleaved pairs of the input samples.
+ * Writes the eight 32 bit results to d.
+ */
+static inline void idctTransform4(__m128i p04, __m128i p26, __m128i p53, __m128i p17, __m128i *d) {
+	const __m128i a0 = madd(p04, 1,  1);
+	const __m128i a1 = madd(p04, 1, -1);
+	const __m128i a2 = madd(p26, 1,  1);
+	const __m128i a3 = _mm_srai_epi32(madd(p26, A1, -A1), 11);
+	const __m128i a4 = madd(p53, 1,  1);
+	const __m128i a6 = madd(p17, 1,  1);
+
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = _mm_srai_epi32(_mm_add_epi32(madd(p53, A3, -A3), madd(p17, A3, -A3)), 11);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(_mm_srai_epi32(madd(p53, A4, -A4), 11), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(_mm_srai_epi32(_mm_sub_epi32(madd(p17, A1, A1), madd(p53, A1, A1)), 11), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(_mm_srai_epi32(madd(p17, A2, -A2), 11), b3), b1);
+
+	const __m128i a02 = _mm_add_epi32(a0, a2);
+	const __m128i a0m2 = _mm_sub_epi32(a0, a2);
+	const __m128i a13 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i a1m3 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+
+	d[0] = _mm_add_epi32(a02, b0);
+	d[1] = _mm_add_epi32(a13, b2);
+	d[2] = _mm_add_epi32(a1m3, b3);
+	d[3] = _mm_sub_epi32(a0m2, b4);
+	d[4] = _mm_add_epi32(a0m2, b4);
+	d[5] = _mm_sub_epi32(a1m3, b3);
+	d[6] = _mm_sub_epi32(a13, b2);
+	d[7] = _mm_sub_epi32(a02, b0);
+}
+
+/** Pack 32 bit values to 16 bits, keeping the lower half like a C cast. */
+static inline __m128i truncate16(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/**
+ * One pass of the transform over all eight lanes of s. For the second
+ * pass, the results are rounded and scaled down.
+ */
+static inline void idctPass(const __m128i *s, __m128i *d, bool rowPass) {
+	__m128i lo[8], hi[8];
+
+	idctTransform4(_mm_unpacklo_epi16(s[0], s[4]), _mm_unpacklo_epi16(s[2], s[6]),
+	               _mm_unpacklo_epi16(s[5], s[3]), _mm_unpacklo_epi16(s[1], s[7]), lo);
+	idctTransform4(_mm_unpackhi_epi16(s[0], s[4]), _mm_unpackhi_epi16(s[2], s[6]),
+	               _mm_unpackhi_epi16(s[5], s[3]), _mm_unpackhi_epi16(s[1], s[7]), hi);
+
+	const __m128i round = _mm_set1_epi32(0x7F);
+	for (int i = 0; i < 8; i++) {
+		if (rowPass) {
+			lo[i] = _mm_srai_epi32(_mm_add_epi32(lo[i], round), 8);
+			hi[i] = _mm_srai_epi32(_mm_add_epi32(hi[i], round), 8);
+		}
+
+		d[i] = truncate16(lo[i], hi[i]);
+	}
+}
+
+static inline void transpose8x8(__m128i *r) {
+	const __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+	const __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+	const __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+	const __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+	const __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+	const __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+	const __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+	const __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+	const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+	const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+	const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+	const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+	const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+	const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+	const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+	const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+	r[0] = _mm_unpacklo_epi64(u0, u4);
+	r[1] = _mm_unpackhi_epi64(u0, u4);
+	r[2] = _mm_unpacklo_epi64(u1, u5);
+	r[3] = _mm_unpackhi_epi64(u1, u5);
+	r[4] = _mm_unpacklo_epi64(u2, u6);
+	r[5] = _mm_unpackhi_epi64(u2, u6);
+	r[6] = _mm_unpacklo_epi64(u3, u7);
+	r[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+/** Transform the block, returning its rows in r. */
+static inline void idctRows(const int16 *block, __m128i *r) {
+	__m128i s[8];
+	for (int i = 0; i < 8; i++)
+		s[i] = _mm_loadu_si128((const __m128i *)(block + 8 * i));
+
+	// Columns first, then the rows of the result
+	idctPass(s, r, false);
+	transpose8x8(r);
+	idctPass(r, s, true);
+
+	for (int i = 0; i < 8; i++)
+		r[i] = s[i];
+	transpose8x8(r);
+}
+
+/** Return the lower 8 bits of the 16 bit samples in the low half of a vector. */
+static inline __m128i lowBytes(__m128i v) {
+	return _mm_packus_epi16(_mm_and_si128(v, _mm_set1_epi16(0xFF)), _mm_setzero_si128());
+}
+
+static inline void addRow(byte *dest, __m128i v) {
+	const __m128i pixels = _mm_loadl_epi64((const __m128i *)dest);
+	_mm_storel_epi64((__m128i *)dest, _mm_add_epi8(pixels, lowBytes(v)));
+}
+
+static inline void putScaledRow(byte *dest, uint32 pitch, __m128i pixels) {
+	const __m128i doubled = _mm_unpacklo_epi8(pixels, pixels);
+	_mm_storeu_si128((__m128i *)dest, doubled);
+	_mm_storeu_si128((__m128i *)(dest + pitch), doubled);
+}
+
+void binkIDCT(int16 *block) {
+	__m128i r[8];
+	idctRows(block, r);
+
+	for (int i = 0; i < 8; i++)
+		_mm_storeu_si128((__m128i *)(block + 8 * i), r[i]);
+}
+
+void binkIDCTPut(byte *dest, uint32 pitch, const int16 *block) {
+	__m128i r[8];
+	idctRows(block, r);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		_mm_storel_epi64((__m128i *)dest, lowBytes(r[i]));
+}
+
+void binkIDCTAdd(byte *dest, uint32 pitch, const int16 *block) {
+	__m128i r[8];
+	idctRows(block, r);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		addRow(dest, r[i]);
+}
+
+void binkIDCTPutScaled(byte *dest, uint32 pitch, const int16 *block) {
+	__m128i r[8];
+	idctRows(block, r);
+
+	for (int i = 0; i < 8; i++, dest += pitch << 1)
+		putScaledRow(dest, pitch, lowBytes(r[i]));
+}
+
+void binkAddResidue(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		addRow(dest, _mm_loadu_si128((const __m128i *)block));
+}
+
+void binkPutScaled(byte *dest, uint32 pitch, const byte *src) {
+	for (int i = 0; i < 8; i++, dest += pitch << 1, src += 8)
+		putScaledRow(dest, pitch, _mm_loadl_epi64((const __m128i *)src));
+}
+
+#else
+
+#define IDCT_TRANSFORM(dest,s0,s1,s2,s3,s4,s5,s6,s7,d0,d1,d2,d3,d4,d5,d6,d7,munge,src) {\
+    const int a0 = (src)[s0] + (src)[s4]; \
+    const int a1 = (src)[s0] - (src)[s4]; \
+    const int a2 = (src)[s2] + (src)[s6]; \
+    const int a3 = (A1*((src)[s2] - (src)[s6])) >> 11; \
+    const int a4 = (src)[s5] + (src)[s3]; \
+    const int a5 = (src)[s5] - (src)[s3]; \
+    const int a6 = (src)[s1] + (src)[s7]; \
+    const int a7 = (src)[s1] - (src)[s7]; \
+    const int b0 = a4 + a6; \
+    const int b1 = (A3*(a5 + a7)) >> 11; \
+    const int b2 = ((A4*a5) >> 11) - b0 + b1; \
+    const int b3 = (A1*(a6 - a4) >> 11) - b2; \
+    const int b4 = ((A2*a7) >> 11) + b3 - b1; \
+    (dest)[d0] = munge(a0+a2   +b0); \
+    (dest)[d1] = munge(a1+a3-a2+b2); \
+    (dest)[d2] = munge(a1-a3+a2+b3); \
+    (dest)[d3] = munge(a0-a2   -b4); \
+    (dest)[d4] = munge(a0-a2   +b4); \
+    (dest)[d5] = munge(a1-a3+a2-b3); \
+    (dest)[d6] = munge(a1+a3-a2-b2); \
+    (dest)[d7] = munge(a0+a2   -b0); \
+}
+/* end IDCT_TRANSFORM macro */
+
+#define MUNGE_NONE(x) (x)
+#define IDCT_COL(dest,src) IDCT_TRANSFORM(dest,0,8,16,24,32,40,48,56,0,8,16,24,32,40,48,56,MUNGE_NONE,src)
+
+#define MUNGE_ROW(x) (((x) + 0x7F)>>8)
+#define IDCT_ROW(dest,src) IDCT_TRANSFORM(dest,0,1,2,3,4,5,6,7,0,1,2,3,4,5,6,7,MUNGE_ROW,src)
+
+static inline void IDCTCol(int16 *dest, const int16 *src) {
+	if ((src[8] | src[16] | src[24] | src[32] | src[40] | src[48] | src[56]) == 0) {
+		dest[ 0] =
+		dest[ 8] =
+		dest[16] =
+		dest[24] =
+		dest[32] =
+		dest[40] =
+		dest[48] =
+		dest[56] = src[0];
+	} else {
+		IDCT_COL(dest, src);
+	}
+}
+
+void binkIDCT(int16 *block) {
+	int i;
+	int16 temp[64];
+
+	for (i = 0; i < 8; i++)
+		IDCTCol(&temp[i], &block[i]);
+	for (i = 0; i < 8; i++) {
+		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+	}
+}
+
+void binkIDCTPut(byte *dest, uint32 pitch, const int16 *block) {
+	int i;
+	int16 temp[64];
+	for (i = 0; i < 8; i++)
+		IDCTCol(&temp[i], &block[i]);
+	for (i = 0; i < 8; i++) {
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
+	}
+}
+
+void binkIDCTAdd(byte *dest, uint32 pitch, const int16 *block) {
+	int16 temp[64];
+	memcpy(temp, block, sizeof(temp));
+	binkIDCT(temp);
+
+	binkAddResidue(dest, pitch, temp);
+}
+
+void binkIDCTPutScaled(byte *dest, uint32 pitch, const int16 *block) {
+	int16 temp[64];
+	memcpy(temp, block, sizeof(temp));
+	binkIDCT(temp);
+
+	const int16 *src = temp;
+	byte *dest1 = dest;
+	byte *dest2 = dest + pitch;
+	for (int j = 0; j < 8; j++, dest1 += (pitch << 1) - 16, dest2 += (pitch << 1) - 16, src += 8) {
+
+		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
+			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+
+	}
+}
+
+void binkAddResidue(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		for (int j = 0; j < 8; j++)
+			dest[j] += block[j];
+}
+
+void binkPutScaled(byte *dest, uint32 pitch, const byte *src) {
+	byte *dest1 = dest;
+	byte *dest2 = dest + pitch;
+	for (int j = 0; j < 8; j++, dest1 += (pitch << 1) - 16, dest2 += (pitch << 1) - 16, src += 8) {
+
+		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
+			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+
+	}
+}
+
+#endif
+
+} // End of namespace Video
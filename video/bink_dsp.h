@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * @file
+ * Block kernels of the Bink video decoder.
+ *
+ * All of them work on a single 8x8 block, given as 64 coefficients or
+ * pixels in row order. Pixels are written to a plane with the given pitch.
+ * Like in the original codec, results are not clamped: only the lowest
+ * 8 bits of a sample end up in the plane.
+ *
+ * When compiled with SSE2 support, the transforms and the adding of
+ * residues process a whole row or column of the block at once. The
+ * results are identical to the plain C versions.
+ */
+
+/** Apply the inverse DCT to the block, in place. */
+void binkIDCT(int16 *block);
+
+/** Apply the inverse DCT to the block and store the result in dest. */
+void binkIDCTPut(byte *dest, uint32 pitch, const int16 *block);
+
+/** Apply the inverse DCT to the block and add the result to dest. */
+void binkIDCTAdd(byte *dest, uint32 pitch, const int16 *block);
+
+/**
+ * Apply the inverse DCT to the block and store the result, scaled up to
+ * a 16x16 block, in dest.
+ */
+void binkIDCTPutScaled(byte *dest, uint32 pitch, const int16 *block);
+
+/** Add the residue in block to dest. */
+void binkAddResidue(byte *dest, uint32 pitch, const int16 *block);
+
+/** Store the 8x8 pixels in src, scaled up to a 16x16 block, in dest. */
+void binkPutScaled(byte *dest, uint32 pitch, const byte *src);
+
+} // End of namespace Video
+
+#endif
@@ -30,6 +30,7 @@
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
@@ -49,6 +50,10 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAheadLimit = 0;
+	_decodeAheadTrack = 0;
+	_decodeAheadFrame = 0;
+	_decodeAheadCost = 0;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -57,10 +62,24 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	flushDecodeAhead();
+
+	if (_decodeAheadFrame)
+		freeDecodedFrame(_decodeAheadFrame);
+}
+
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	flushDecodeAhead();
+
+	if (_decodeAheadFrame) {
+		freeDecodedFrame(_decodeAheadFrame);
+		_decodeAheadFrame = 0;
+	}
+
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		delete *it;
 
@@ -185,6 +204,33 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	// The previously returned frame is not needed anymore
+	if (_decodeAheadFrame) {
+		freeDecodedFrame(_decodeAheadFrame);
+		_decodeAheadFrame = 0;
+	}
+
+	if (_decodeAheadLimit) {
+		_decodeAheadStats.queueDepthSum += _decodeAheadQueue.size();
+
+		if (!_decodeAheadQueue.empty()) {
+			_decodeAheadFrame = _decodeAheadQueue.front();
+			_decodeAheadQueue.pop_front();
+			_decodeAheadStats.framesFromQueue++;
+
+			if (_decodeAheadFrame->dirtyPalette) {
+				memcpy(_decodeAheadPalette, _decodeAheadFrame->palette, sizeof(_decodeAheadPalette));
+				_palette = _decodeAheadPalette;
+				_dirtyPalette = true;
+			}
+
+			findNextVideoTrack();
+			return _decodeAheadFrame->surface;
+		}
+
+		_decodeAheadStats.framesOnDemand++;
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -213,6 +259,8 @@ bool VideoDecoder::setReverse(bool reverse) {
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
+			flushDecodeAhead();
+
 			if (!((VideoTrack *)*it)->setReverse(reverse))
 				return false;
 
@@ -234,7 +282,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getTrackCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -275,7 +323,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getTrackNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -294,7 +342,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if (!(*it)->endOfTrack() && (!isPlaying() || (*it)->getTrackType() != Track::kTrackTypeVideo || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
+		if (!isTrackAtEnd(*it) && (!isPlaying() || (*it)->getTrackType() != Track::kTrackTypeVideo || !_endTimeSet || getTrackNextFrameStartTime((const VideoTrack *)*it) < (uint)_endTime.msecs()))
 			return false;
 
 	return true;
@@ -315,6 +363,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -349,6 +399,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -856,7 +908,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackAtEnd(*it))
 			return false;
 
 	return true;
@@ -867,9 +919,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackAtEnd(*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getTrackNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -911,7 +963,7 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack() && (!isPlaying() || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackAtEnd(*it) && (!isPlaying() || !_endTimeSet || getTrackNextFrameStartTime((const VideoTrack *)*it) < (uint)_endTime.msecs()))
 			return true;
 
 	return false;
@@ -942,4 +994,119 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+void VideoDecoder::setDecodeAhead(uint maxFrames) {
+	_decodeAheadLimit = maxFrames;
+
+	if (!maxFrames)
+		flushDecodeAhead();
+}
+
+bool VideoDecoder::decodeAhead() {
+	if (!_decodeAheadLimit || _decodeAheadQueue.size() >= _decodeAheadLimit)
+		return false;
+
+	VideoTrack *track = findDecodeAheadTrack();
+	if (!track || track->endOfTrack())
+		return false;
+
+	if (_endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs())
+		return false;
+
+	// Do not risk delaying the next frame for a later one. If the queue is
+	// empty, the frame to decode is the next one anyway.
+	if (!_decodeAheadQueue.empty() && getTimeToNextFrame() <= _decodeAheadCost)
+		return false;
+
+	_canSetDither = false;
+	_decodeAheadTrack = track;
+
+	DecodedFrame *frame = new DecodedFrame();
+	frame->curFrame = track->getCurFrame();
+	frame->startTime = track->getNextFrameStartTime();
+	frame->surface = 0;
+
+	const uint32 startTime = g_system->getMillis();
+
+	readNextPacket();
+	const Graphics::Surface *surface = track->decodeNextFrame();
+	if (surface) {
+		frame->surface = new Graphics::Surface();
+		frame->surface->copyFrom(*surface);
+	}
+
+	frame->dirtyPalette = track->hasDirtyPalette();
+	if (frame->dirtyPalette)
+		memcpy(frame->palette, track->getPalette(), sizeof(frame->palette));
+
+	// Keep a moving average of the decoding time, rounded up
+	const uint32 cost = g_system->getMillis() - startTime;
+	_decodeAheadCost = (_decodeAheadCost * 3 + cost + 3) / 4;
+
+	_decodeAheadQueue.push_back(frame);
+	_decodeAheadStats.framesDecodedAhead++;
+	_decodeAheadStats.maxQueueDepth = MAX<uint32>(_decodeAheadStats.maxQueueDepth, _decodeAheadQueue.size());
+
+	findNextVideoTrack();
+	return true;
+}
+
+VideoDecoder::VideoTrack *VideoDecoder::findDecodeAheadTrack() const {
+	VideoTrack *track = 0;
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			// We only decode ahead when one video track is present
+			if (track)
+				return 0;
+
+			track = (VideoTrack *)*it;
+		}
+	}
+
+	if (track && track->isReversed())
+		return 0;
+
+	return track;
+}
+
+void VideoDecoder::flushDecodeAhead() {
+	while (!_decodeAheadQueue.empty()) {
+		freeDecodedFrame(_decodeAheadQueue.front());
+		_decodeAheadQueue.pop_front();
+	}
+
+	_decodeAheadTrack = 0;
+}
+
+void VideoDecoder::freeDecodedFrame(DecodedFrame *frame) {
+	if (frame->surface) {
+		frame->surface->free();
+		delete frame->surface;
+	}
+
+	delete frame;
+}
+
+bool VideoDecoder::isTrackAtEnd(const Track *track) const {
+	// A track with frames left in the queue has not ended yet
+	if (track == _decodeAheadTrack && !_decodeAheadQueue.empty())
+		return false;
+
+	return track->endOfTrack();
+}
+
+int VideoDecoder::getTrackCurFrame(const VideoTrack *track) const {
+	if (track == _decodeAheadTrack && !_decodeAheadQueue.empty())
+		return _decodeAheadQueue.front()->curFrame;
+
+	return track->getCurFrame();
+}
+
+uint32 VideoDecoder::getTrackNextFrameStartTime(const VideoTrack *track) const {
+	if (track == _decodeAheadTrack && !_decodeAheadQueue.empty())
+		return _decodeAheadQueue.front()->startTime;
+
+	return track->getNextFrameStartTime();
+}
+
 } // End of namespace Video
@@ -26,6 +26,7 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/list.h"
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
@@ -52,7 +53,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -396,6 +397,80 @@ public:
 	 */
 	bool setDitheringPalette(const byte *palette);
 
+	/////////////////////////////////////////
+	// Decode-Ahead
+	/////////////////////////////////////////
+
+	/**
+	 * Statistics about decoding frames ahead of time.
+	 */
+	struct DecodeAheadStats {
+		DecodeAheadStats() : framesDecodedAhead(0), framesFromQueue(0), framesOnDemand(0), maxQueueDepth(0), queueDepthSum(0) {}
+
+		/** Number of frames decoded ahead by decodeAhead(). */
+		uint32 framesDecodedAhead;
+		/** Number of frames decodeNextFrame() took from the queue. */
+		uint32 framesFromQueue;
+		/** Number of frames decodeNextFrame() had to decode itself, since the queue was empty. */
+		uint32 framesOnDemand;
+		/** The largest number of queued frames so far. */
+		uint32 maxQueueDepth;
+		/**
+		 * Sum of the queue depths at every call of decodeNextFrame(). Divide
+		 * by framesFromQueue + framesOnDemand for the average depth.
+		 */
+		uint32 queueDepthSum;
+	};
+
+	/**
+	 * Enable decoding frames ahead of time.
+	 *
+	 * Decoding a frame may take long enough for the frame to be shown late,
+	 * even though the time between frames was spent idling. In decode-ahead
+	 * mode, engines call decodeAhead() while waiting for the next frame,
+	 * which decodes upcoming frames into a queue. decodeNextFrame() then
+	 * returns the queued frames, without any decoding work.
+	 *
+	 * This is only used for videos with a single video track, which is
+	 * not reversed. The queue is flushed on seeking, rewinding and
+	 * changing the direction of playback, and kept while paused.
+	 *
+	 * All methods of VideoDecoder report the state of the last frame
+	 * returned by decodeNextFrame(). However, the tracks themselves
+	 * reflect the last frame decoded ahead. Hence subclasses which query
+	 * their tracks directly should not use decode-ahead.
+	 *
+	 * The setting is kept when another video is loaded.
+	 *
+	 * @param maxFrames the maximal number of frames to queue, 0 disables
+	 *                  decode-ahead (which is the default)
+	 */
+	void setDecodeAhead(uint maxFrames);
+
+	/**
+	 * Get the maximal number of frames to decode ahead.
+	 */
+	uint getDecodeAhead() const { return _decodeAheadLimit; }
+
+	/**
+	 * Decode one frame ahead of time, if decode-ahead is enabled, the queue
+	 * is not full yet, and there is enough time left until the next frame
+	 * is due.
+	 *
+	 * @return true if a frame was decoded
+	 */
+	bool decodeAhead();
+
+	/**
+	 * Get the statistics about decoding ahead.
+	 */
+	const DecodeAheadStats &getDecodeAheadStats() const { return _decodeAheadStats; }
+
+	/**
+	 * Reset the statistics about decoding ahead.
+	 */
+	void resetDecodeAheadStats() { _decodeAheadStats = DecodeAheadStats(); }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -964,6 +1039,32 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decode-ahead
+	struct DecodedFrame {
+		Graphics::Surface *surface;
+		int curFrame;
+		uint32 startTime;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	typedef Common::List<DecodedFrame *> DecodedFrameQueue;
+
+	VideoTrack *findDecodeAheadTrack() const;
+	void flushDecodeAhead();
+	void freeDecodedFrame(DecodedFrame *frame);
+	bool isTrackAtEnd(const Track *track) const;
+	int getTrackCurFrame(const VideoTrack *track) const;
+	uint32 getTrackNextFrameStartTime(const VideoTrack *track) const;
+
+	uint _decodeAheadLimit;
+	VideoTrack *_decodeAheadTrack;
+	DecodedFrameQueue _decodeAheadQueue;
+	DecodedFrame *_decodeAheadFrame;
+	uint32 _decodeAheadCost;
+	byte _decodeAheadPalette[256 * 3];
+	DecodeAheadStats _decodeAheadStats;
 };
 
 } // End of namespace Video